@@ -14,7 +14,7 @@ using namespace std;
 
 // Constructor to initialize a book with given details
 Book::Book(string title, string author, string isbn, int publication_year, int total_copies, int available_copies)
-    : title(title), author(author), isbn(isbn), publication_year(publication_year), total_copies(total_copies), available_copies(available_copies) {}
+    : title(title), author(author), isbn(isbn), publication_year(publication_year), total_copies(total_copies), available_copies(available_copies), category(nullptr), row(-1), searchId(-1) {}
 
 // Display function to show the details of the book
 void Book::display() {
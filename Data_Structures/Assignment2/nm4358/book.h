@@ -11,6 +11,7 @@
 #include<string>
 #include "myvector.h"
 class Borrower;
+class Node;
 class Book
 {
 	private:
@@ -20,8 +21,11 @@ class Book
 		int publication_year;
 		int total_copies;
 		int available_copies;
-		MyVector<Borrower*> currentBorrowers;		//current borrowers of the book
+		SmallVector<Borrower*, 2> currentBorrowers;	//current borrowers of the book, usually none or a few
 		MyVector<Borrower*> allBorrowers;   //history of all borrowers of the book
+		Node* category;						//category node the book is filed under
+		int row;							//row in the tree's book columns, -1 if it has none
+		int searchId;						//ID in the tree's title search, -1 until the book is first filed
 
 	public:
 		Book(std::string title, std::string author, std::string isbn, int publication_year,int total_copies, int available_copies);
@@ -31,5 +35,7 @@ class Book
 		friend class Node;
 		friend class LCMS;
 		friend class Borrower;
+		friend class BookColumns;
+		friend class TitleSearch;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+//============================================================================
+// Name         : bookcolumns.cpp
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Column store of the numeric Book fields for predicate scans
+//============================================================================
+
+#include "bookcolumns.h"
+#include "book.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+const vector<int>& BookColumns::column(int column) const {
+    switch (column) {
+    case YEAR:      return years;
+    case TOTAL:     return totals;
+    case AVAILABLE: return available;
+    default:        return categories;
+    }
+}
+
+int BookColumns::columnByName(const string& name) {
+    if (name == "year") return YEAR;
+    if (name == "total") return TOTAL;
+    if (name == "available") return AVAILABLE;
+    if (name == "category") return CATEGORY;
+    return -1;
+}
+
+void BookColumns::add(Book* book, int category) {
+    book->row = books.size();
+    years.push_back(book->publication_year);
+    totals.push_back(book->total_copies);
+    available.push_back(book->available_copies);
+    categories.push_back(category);
+    books.push_back(book);
+}
+
+// Move the last row into the hole so the columns stay dense
+void BookColumns::remove(Book* book) {
+    int row = book->row;
+    if (row < 0 || row >= size() || books[row] != book) return;
+    int last = size() - 1;
+    years[row] = years[last];
+    totals[row] = totals[last];
+    available[row] = available[last];
+    categories[row] = categories[last];
+    books[row] = books[last];
+    books[row]->row = row;
+    years.pop_back();
+    totals.pop_back();
+    available.pop_back();
+    categories.pop_back();
+    books.pop_back();
+    book->row = -1;
+}
+
+void BookColumns::update(Book* book) {
+    int row = book->row;
+    if (row < 0 || row >= size() || books[row] != book) return;
+    years[row] = book->publication_year;
+    totals[row] = book->total_copies;
+    available[row] = book->available_copies;
+}
+
+void BookColumns::reserve(size_t count) {
+    years.reserve(years.size() + count);
+    totals.reserve(totals.size() + count);
+    available.reserve(available.size() + count);
+    categories.reserve(categories.size() + count);
+    books.reserve(books.size() + count);
+}
+
+int BookColumns::size() const {
+    return books.size();
+}
+
+// match[i] &= low <= values[i] <= high, as one unsigned compare: values[i] - low wraps around when below low
+static void andRange(unsigned char* __restrict match, const int* __restrict values, int n, unsigned int low, unsigned int width) {
+    for (int i = 0; i < n; i++) {
+        match[i] &= ((unsigned int)values[i] - low) <= width;
+    }
+}
+
+// match[i] &= inside[ids[i]]
+static void andCategory(unsigned char* __restrict match, const int* __restrict ids, int n, const unsigned char* __restrict inside) {
+    for (int i = 0; i < n; i++) {
+        match[i] &= inside[ids[i]];
+    }
+}
+
+// Rows are scanned in blocks small enough for the match bytes to stay in L1: every predicate ANDs
+// into one byte per row without branches, a loop the compiler turns into vector compares, and
+// only then are the matching rows of the block collected.
+int BookColumns::select(const vector<ColumnRange>& ranges, const vector<unsigned char>* categoryMask, vector<Book*>& matches) const {
+    for (size_t r = 0; r < ranges.size(); r++) {
+        if (ranges[r].low > ranges[r].high) return 0;
+    }
+    const int BLOCK = 4096;
+    unsigned char match[BLOCK];
+    int n = size();
+    for (int start = 0; start < n; start += BLOCK) {
+        int count = min(BLOCK, n - start);
+        memset(match, 1, count);
+        for (size_t r = 0; r < ranges.size(); r++) {
+            andRange(match, column(ranges[r].column).data() + start, count, ranges[r].low, (unsigned int)ranges[r].high - ranges[r].low);
+        }
+        if (categoryMask) andCategory(match, categories.data() + start, count, categoryMask->data());
+        for (int i = 0; i < count; i++) {
+            if (match[i]) matches.push_back(books[start + i]);
+        }
+    }
+    return n;
+}
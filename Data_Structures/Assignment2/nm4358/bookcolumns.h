@@ -0,0 +1,48 @@
+//============================================================================
+// Name         : bookcolumns.h
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Column store of the numeric Book fields for predicate scans
+//============================================================================
+#ifndef _BOOKCOLUMNS_H
+#define _BOOKCOLUMNS_H
+#include<string>
+#include<vector>
+using namespace std;
+class Book;
+
+// Inclusive range [low, high] over one column
+struct ColumnRange
+{
+	int column;		//BookColumns::Column
+	int low;
+	int high;
+};
+
+// One row per book, each field in its own contiguous array, so a predicate is a
+// tight loop over plain ints. The rows are unordered: removing a book moves the last row into its place.
+class BookColumns
+{
+	private:
+		vector<int> years;			//publication year
+		vector<int> totals;			//total copies
+		vector<int> available;		//available copies
+		vector<int> categories;		//ID of the category node
+		vector<Book*> books;		//the book each row belongs to
+		const vector<int>& column(int column) const;
+
+	public:
+		enum Column { YEAR, TOTAL, AVAILABLE, CATEGORY };
+		static int columnByName(const string& name);	//"year", "total", "available" or "category", -1 otherwise
+		void add(Book* book, int category);	//append a row and remember it in book->row
+		void remove(Book* book);			//drop a book's row
+		void update(Book* book);			//copy year and copies again after the book changed; ignores books not stored here
+		void reserve(size_t count);			//make room for count more rows
+		int size() const;
+		// Rows matching every range, and with categoryMask given, whose category ID is set in it;
+		// returns the number of rows scanned, 0 when a range is empty
+		int select(const vector<ColumnRange>& ranges, const vector<unsigned char>* categoryMask, vector<Book*>& matches) const;
+};
+#endif
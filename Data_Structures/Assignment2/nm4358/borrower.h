@@ -17,7 +17,7 @@ class Borrower
 	private:
 		string name;
 		string id;
-		MyVector<Book*> books_borrowed;
+		SmallVector<Book*, 2> books_borrowed;	//books currently out, usually none or a few
 	public:
 		Borrower(string name, string id);
 		friend class LCMS;
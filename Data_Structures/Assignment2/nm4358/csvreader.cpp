@@ -0,0 +1,171 @@
+//============================================================================
+// Name         : csvreader.cpp
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : RFC 4180 CSV reading (memory-mapped) and quoting for catalog import/export
+//============================================================================
+
+#include "csvreader.h"
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Map the whole file read-only and locate the end of the header row
+CsvReader::CsvReader(string path) : data(nullptr), length(0), bodyStart(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("Failed to open file: " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Failed to read file: " + path);
+    }
+    length = info.st_size;
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw runtime_error("Failed to map file: " + path);
+        }
+        data = (const char*)mapping;
+        madvise(mapping, length, MADV_SEQUENTIAL);
+    }
+    close(fd);      // the mapping stays valid without the descriptor
+
+    // Skip the header row
+    const char* p = begin();
+    vector<string> fields;
+    int count;
+    bool wellFormed;
+    nextRecord(p, end(), fields, count, wellFormed);
+    bodyStart = p - begin();
+}
+
+CsvReader::~CsvReader() {
+    if (data) munmap((void*)data, length);
+}
+
+const char* CsvReader::begin() {
+    return data;
+}
+
+const char* CsvReader::end() {
+    return data + length;
+}
+
+// Cut the body into roughly equal ranges that each start at the beginning of a record
+vector<pair<size_t, size_t> > CsvReader::split(unsigned int parts) {
+    size_t body = length - bodyStart;
+    if (parts == 0 || body < parts) parts = 1;
+
+    // A newline ends a record only outside quotes. Escaped quotes ("") come in pairs, so the
+    // parity of the quotes before an offset tells whether it is inside a quoted field.
+    vector<size_t> quotes(parts, 0);
+    vector<thread> workers;
+    for (unsigned int t = 0; t < parts; t++) {
+        workers.push_back(thread([&, t]() {
+            const char* p = data + bodyStart + body * t / parts;
+            const char* stop = data + bodyStart + body * (t + 1) / parts;
+            while (p < stop && (p = (const char*)memchr(p, '"', stop - p)) != nullptr) {
+                quotes[t]++;
+                p++;
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+    vector<size_t> starts(1, bodyStart);
+    size_t quotesBefore = 0;
+    for (unsigned int t = 1; t < parts; t++) {
+        quotesBefore += quotes[t - 1];
+        bool inQuotes = quotesBefore % 2 == 1;
+        const char* p = data + bodyStart + body * t / parts;
+        // The first newline outside quotes ends the record this part would otherwise start inside
+        while (p < end() && (inQuotes || *p != '\n')) {
+            if (*p == '"') inQuotes = !inQuotes;
+            p++;
+        }
+        size_t start = (p < end()) ? p - data + 1 : length;
+        if (start > starts.back() && start < length) starts.push_back(start);
+    }
+
+    vector<pair<size_t, size_t> > ranges;
+    for (size_t i = 0; i < starts.size(); i++) {
+        ranges.push_back(make_pair(starts[i], i + 1 < starts.size() ? starts[i + 1] : length));
+    }
+    return ranges;
+}
+
+// Quote only when needed; nextRecord turns the result back into the same field
+void appendCsvField(string& out, const string& field) {
+    if (field.find_first_of(",\"\r\n") == string::npos) {
+        out += field;
+        return;
+    }
+    out += '"';
+    size_t start = 0, quote;
+    while ((quote = field.find('"', start)) != string::npos) {
+        out.append(field, start, quote + 1 - start);
+        out += '"';
+        start = quote + 1;
+    }
+    out.append(field, start, string::npos);
+    out += '"';
+}
+
+// Single pass over one record; the strings in fields are reused between calls
+bool CsvReader::nextRecord(const char*& p, const char* end, vector<string>& fields, int& count, bool& wellFormed) {
+    count = 0;
+    wellFormed = true;
+    if (p >= end) return false;
+    while (true) {
+        if (count == (int)fields.size()) fields.push_back("");
+        string& field = fields[count++];
+        field.clear();
+        if (p < end && *p == '"') {
+            // Quoted field: may hold commas and newlines, "" stands for one quote
+            p++;
+            while (true) {
+                const char* quote = (const char*)memchr(p, '"', end - p);
+                if (quote == nullptr) {
+                    field.append(p, end);
+                    p = end;
+                    wellFormed = false;
+                    break;
+                }
+                field.append(p, quote);
+                p = quote + 1;
+                if (p < end && *p == '"') {
+                    field += '"';
+                    p++;
+                } else break;
+            }
+            // Anything between the closing quote and the delimiter is kept but flagged
+            while (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                field += *p++;
+                wellFormed = false;
+            }
+        } else {
+            const char* stop = p;
+            while (stop < end && *stop != ',' && *stop != '\n' && *stop != '\r') stop++;
+            field.assign(p, stop);
+            p = stop;
+        }
+        if (p >= end) return true;
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+        // End of record: \n or \r\n
+        if (*p == '\r') p++;
+        if (p < end && *p == '\n') p++;
+        return true;
+    }
+}
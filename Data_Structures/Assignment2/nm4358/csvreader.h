@@ -0,0 +1,38 @@
+//============================================================================
+// Name         : csvreader.h
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : RFC 4180 CSV reading (memory-mapped) and quoting for catalog import/export
+//============================================================================
+#ifndef _CSVREADER_H
+#define _CSVREADER_H
+#include<string>
+#include<vector>
+#include<utility>
+using namespace std;
+
+class CsvReader
+{
+	private:
+		const char* data;		//mapped file contents
+		size_t length;			//size of the mapping in bytes
+		size_t bodyStart;		//offset of the first record after the header row
+
+	public:
+		CsvReader(string path);	//map a file, throws runtime_error if it cannot be read
+		~CsvReader();
+		const char* begin();
+		const char* end();
+		// Split the records after the header into at most parts ranges [first, second) of
+		// byte offsets. Every range starts on a record boundary, even if quoted fields contain newlines.
+		vector<pair<size_t, size_t> > split(unsigned int parts);
+		// Parse the record at p into fields[0..count) and move p past it. Returns false at the
+		// end of input; wellFormed is false for unterminated quotes or text after a closing quote.
+		static bool nextRecord(const char*& p, const char* end, vector<string>& fields, int& count, bool& wellFormed);
+};
+
+// Append a field to a CSV row, quoted (with "" for quotes) only if it holds a comma, quote or line break
+void appendCsvField(string& out, const string& field);
+#endif
@@ -11,10 +11,21 @@
 #include "book.h"
 #include "tree.h"
 #include "myvector.h"
+#include "csvreader.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <ios>
+#include <limits>
+#include <stack>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdlib>
+#include <stdexcept>
+#include <climits>
+#include <unistd.h>
 
 using namespace std;
 
@@ -26,175 +37,106 @@ LCMS::LCMS(string name) {
 
 // Destructor
 LCMS::~LCMS() {
-    delete libTree;
+    delete libTree;     // borrowerPool frees the borrowers after this
     cout << "LCMS cleaned up." << endl;
 }
 
+// Parse a whole CSV field as an integer
+static bool toInt(const string& text, int& value) {
+    if (text.empty()) return false;
+    char* stop;
+    long parsed = strtol(text.c_str(), &stop, 10);
+    if (*stop != '\0') return false;
+    value = (int)parsed;
+    return true;
+}
+
 // Import books from a CSV file
 int LCMS::import(string path) {
-    ifstream file(path); 
-    if (!file) {
-        cout << !file << endl;
-        cerr << "Failed to open file: " << path << endl;
-        return -1;
-    }
-    int n = 0;
-    string line;
-    getline(file, line);
-    while (getline(file, line)) {
-        //CSV file format
-        //Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies
-
-        stringstream ss(line);
-        string title, author, isbn, category;
-        int pub_year, total_copies, available_copies; 
-
-        // Extract title, handling quotes
-        if (line[0] == '"') {  // Title is enclosed in quotes
-            size_t endPos = line.find('"', 1);
-            if (endPos != string::npos) {
-                title = line.substr(1, endPos - 1);
-                line = line.substr(title.length() + 3); // Update the line after extracting the title
-            } else {
-                cerr << "Malformed title in line: " << line << std::endl;
-                continue;
-            }
-        } else {
-            getline(ss, title, ',');
-            line = line.substr(title.length() + 1); // Update the line after extracting the title
+    //CSV file format (RFC 4180, any field may be quoted)
+    //Title,Author,ISBN,Publication Year,Category[,Total Copies[,Available Copies]]
+    try {
+        CsvReader reader(path);
+        unsigned int threads = thread::hardware_concurrency();
+        vector<pair<size_t, size_t> > ranges = reader.split(threads == 0 ? 1 : threads);
+
+        // Every part parses its rows into books on its own thread, in a pool of its own;
+        // the tree is not touched yet
+        vector<vector<pair<string, Book*> > > parsed(ranges.size());
+        vector<ObjectPool<Book> > pools(ranges.size());
+        vector<vector<string> > malformed(ranges.size());
+        vector<thread> workers;
+        for (size_t t = 0; t < ranges.size(); t++) {
+            workers.push_back(thread([&, t]() {
+                const char* p = reader.begin() + ranges[t].first;
+                const char* stop = reader.begin() + ranges[t].second;
+                vector<string> fields;
+                int count, pub_year, total_copies, available_copies;
+                bool wellFormed;
+                const char* row = p;
+                for (; CsvReader::nextRecord(p, stop, fields, count, wellFormed); row = p) {
+                    if (count == 1 && fields[0].empty()) continue;      // blank line
+                    // Older catalogs stop after Category: one copy, all of them available
+                    total_copies = 1;
+                    if (count > 5 && !toInt(fields[5], total_copies)) wellFormed = false;
+                    available_copies = total_copies;
+                    if (count > 6 && !toInt(fields[6], available_copies)) wellFormed = false;
+                    if (!wellFormed || count < 5 || count > 7 || !toInt(fields[3], pub_year)) {
+                        malformed[t].push_back(string(row, p));
+                        continue;
+                    }
+                    Book* book = pools[t].create(fields[0], fields[1], fields[2], pub_year, total_copies, available_copies);
+                    parsed[t].push_back(make_pair(fields[4], book));
+                }
+            }));
         }
-
-        ss.clear();  // Clear the previous stream state
-        ss.str(line);  // Reset stringstream with the remaining line
-
-        // Now handle author with potential quotes
-        if (line[0] == '"') {  // Author is enclosed in quotes
-            size_t endPos = line.find('"', 1);
-            if (endPos != string::npos) {
-                author = line.substr(1, endPos - 1);
-                line = line.substr(author.length() + 3);
-            } else {
-                cerr << "Malformed author in line: " << line << std::endl;
-                continue;
+        for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+        for (size_t t = 0; t < pools.size(); t++) libTree->adoptBooks(pools[t]);
+
+        // Merge in file order, resolving every distinct category path only once
+        size_t rows = 0;
+        for (size_t t = 0; t < parsed.size(); t++) rows += parsed[t].size();
+        libTree->reserveBooks(rows);
+        libTree->beginBulk();       // book counts are summed once after the merge
+        unordered_map<string, Node*> categories;
+        int n = 0;
+        for (size_t t = 0; t < parsed.size(); t++) {
+            for (size_t i = 0; i < malformed[t].size(); i++) {
+                string& line = malformed[t][i];
+                while (!line.empty() && (line[line.size() - 1] == '\n' || line[line.size() - 1] == '\r')) line.erase(line.size() - 1);
+                cerr << "Malformed record: " << line << endl;
+            }
+            for (size_t i = 0; i < parsed[t].size(); i++) {
+                const string& category = parsed[t][i].first;
+                unordered_map<string, Node*>::iterator it = categories.find(category);
+                if (it == categories.end()) {
+                    // Find or create the category node
+                    Node* categoryNode = libTree->getNode(category);
+                    if (!categoryNode) {
+                        categoryNode = libTree->createNode(category);
+                    }
+                    it = categories.insert(make_pair(category, categoryNode)).first;
+                }
+                // Insert the book into the category node
+                libTree->addBook(it->second, parsed[t][i].second);
+                n++;
             }
-        } else {
-            getline(ss, author, ',');
-            line = line.substr(author.length() + 1);
-        }
-
-        ss.clear();  // Clear the previous stream state
-        ss.str(line);  // Reset stringstream with the remaining line
-        //cout << line << endl;
-        // Parse the rest of the fields
-        getline(ss, isbn, ',');
-        ss >> pub_year;
-        ss.ignore(1, ',');  // Skip comma
-        getline(ss, category, ',');
-        ss >> total_copies;
-        ss.ignore(1, ',');
-        ss >> available_copies;
-        
-        // Create a new book object
-        Book* book = new Book(title, author, isbn, pub_year, total_copies, available_copies);
-
-        // Find or create the category node
-        Node* categoryNode = libTree->getNode(category);
-        if (!categoryNode) {
-            categoryNode = libTree->createNode(category);
-        }
-
-        // Insert the book into the category node
-        categoryNode->books.push_back(book);
-        libTree->updateBookCount(categoryNode, 1);
-        n++;
-        //cout << "Book '" << title << "' added to category '" << category << "'" << std::endl;
         }
-    cout << n << " records have been imported" << endl;
-    file.close();
+        libTree->commitBulk();
+        cout << n << " records have been imported" << endl;
+    } catch (runtime_error& ex) {
+        cerr << ex.what() << endl;
+        return -1;
+    }
     return 0;
 }
 
 // Export all books to a given file
 void LCMS::exportData(string path) {
-    ofstream file(path);
-    if (!file) {
-        cerr << "Failed to open file: " << path << endl;
+    if (libTree->exportAll(path) < 0) {
+        cerr << "Failed to write file: " << path << endl;
         return;
     }
-
-    // Write CSV header
-    file << "Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies" << endl;
-
-    // Initialize stack for iterative tree traversal
-    Node* root = libTree->getRoot();
-    stack<Node*> nodesToVisit;
-    nodesToVisit.push(root);
-
-    while (!nodesToVisit.empty()) {
-        Node* currentNode = nodesToVisit.top();
-        nodesToVisit.pop();
-
-        // Process each book in the current node
-        for (int i = 0; i < currentNode->books.size(); i++) {
-            Book* book = currentNode->books[i];
-
-            // Manually construct each field to handle quotes and commas
-            string title = book->title;
-            string author = book->author;
-            string isbn = book->isbn;
-            int pub_year = book->publication_year;
-            string category = currentNode->name;
-            int total_copies = book->total_copies;
-            int available_copies = book->available_copies;
-
-            // Escape quotes and commas in title
-            file << '"';
-            for (int j = 0; j < title.size(); j++) {
-                if (title[j] == '"') {
-                    file << "\"\"";  // Double quote for escaping
-                } else {
-                    file << title[j];
-                }
-            }
-            file << "\",";
-            
-            // Escape quotes and commas in author
-            file << '"';
-            for (int j = 0; j < author.size(); j++) {
-                if (author[j] == '"') {
-                    file << "\"\"";  // Double quote for escaping
-                } else {
-                    file << author[j];
-                }
-            }
-            file << "\",";
-
-            // Write remaining fields without special escaping
-            file << isbn << ",";
-            file << pub_year << ",";
-            
-            // Escape quotes and commas in category
-            file << '"';
-            for (int j = 0; j < category.size(); j++) {
-                if (category[j] == '"') {
-                    file << "\"\"";  // Double quote for escaping
-                } else {
-                    file << category[j];
-                }
-            }
-            file << "\",";
-
-            file << total_copies << ",";
-            file << available_copies << endl;
-        }
-
-        // Push children nodes onto stack for later traversal
-        for (int i = 0; i < currentNode->children.size(); i++) {
-            nodesToVisit.push(currentNode->children[i]);
-        }
-    }
-
-    file.close();
     cout << "Data exported to " << path << endl;
 }
 
@@ -225,6 +167,49 @@ void LCMS::findBook(string bookTitle) {
     cout << "Book not found." << endl;
 }
 
+// Find the books with a given ISBN (ISBN-10 or ISBN-13, dashes optional) and display their details
+void LCMS::findByISBN(string isbn) {
+    vector<Book*> books = libTree->findByISBN(isbn);
+    if (books.empty()) {
+        cout << "Book not found." << endl;
+        return;
+    }
+    for (size_t i = 0; i < books.size(); i++) {
+        if (books.size() > 1) cout << "Category:          " << books[i]->category->getCategory(books[i]->category) << endl;
+        books[i]->display();
+    }
+}
+
+// List the best matches for some words of a title; case and punctuation do not matter
+void LCMS::searchTitle(string words) {
+    if (TitleSearch::words(words).empty()) throw invalid_argument("searchTitle: expected one or more words of a title");
+    const size_t shown = 20;
+    vector<Book*> books = libTree->searchTitle(words);
+    if (books.empty()) {
+        cout << "No matching books found." << endl;
+        return;
+    }
+    for (size_t i = 0; i < books.size() && i < shown; i++) {
+        cout << books[i]->title << " by " << books[i]->author << " (" << books[i]->category->getCategory(books[i]->category) << ")" << endl;
+    }
+    cout << books.size() << " books found";
+    if (books.size() > shown) cout << ", showing the best " << shown;
+    cout << "." << endl;
+}
+
+// List the books of an author; case and extra spaces in the name do not matter
+void LCMS::findByAuthor(string author) {
+    vector<Book*> books = libTree->findByAuthor(author);
+    if (books.empty()) {
+        cout << "No books by '" << author << "' found." << endl;
+        return;
+    }
+    for (size_t i = 0; i < books.size(); i++) {
+        cout << books[i]->title << " (" << books[i]->publication_year << "), ISBN " << books[i]->isbn << endl;
+    }
+    cout << books.size() << " books found." << endl;
+}
+
 // Add a new book to the catalog
 void LCMS::addBook() {
     string title, author, isbn, category;
@@ -271,18 +256,17 @@ void LCMS::addBook() {
             // Book exists, update the total copies
             existingBook->total_copies += total_copies;
             existingBook->available_copies += total_copies;
+            libTree->syncBook(existingBook);
             cout << "Book updated with additional copies." << endl;
             return;
         }
     }
 
     // Create a new book
-    Book* book = new Book(title, author, isbn, pub_year, total_copies, total_copies);
-
-    // Update the book count in the category node
-    libTree->updateBookCount(categoryNode, 1);
+    Book* book = libTree->createBook(title, author, isbn, pub_year, total_copies, total_copies);
 
-    categoryNode->books.push_back(book);  // Directly add book to the category’s book vector
+    // Add the book to the category, the title index and the book counts
+    libTree->addBook(categoryNode, book);
     cout << title << " has been successfully added into the catalog" << endl;
 
 }
@@ -347,12 +331,14 @@ void LCMS::editBook(string bookTitle) {
         }
     }
     //cout << new_title << endl;
-    book->title = (new_title.empty() ? book->title : new_title);
-    book->author = (new_author.empty() ? book->author : new_author);
-    book->isbn = (new_isbn.empty() ? book->isbn : new_isbn);
+    // Title, author and ISBN are indexed, so the tree changes them together with the indexes
+    libTree->updateBook(book, (new_title.empty() ? book->title : new_title),
+                        (new_author.empty() ? book->author : new_author),
+                        (new_isbn.empty() ? book->isbn : new_isbn));
     book->publication_year = (new_pub_year != 2050 ? new_pub_year : book->publication_year);
     book->total_copies = (new_total_copies != -1 ? new_total_copies : book->total_copies);
     book->available_copies = (new_available_copies != -1 ? new_available_copies : book->available_copies);
+    libTree->syncBook(book);
 }
 
 // Borrow a book
@@ -380,16 +366,10 @@ void LCMS::borrowBook(string bookTitle) {
     // If borrower is not found
     if (!borrower) {
         cout << "Borrower not registered. Creating new registration" << endl;
-        Borrower* newBorrower = new Borrower(borrower_name, borrower_id);
-        borrowers.push_back(newBorrower);
-        borrower = newBorrower;
+        borrower = registerBorrower(borrower_name, borrower_id);
     }
 
-    // Process the borrowing manually
-    book->available_copies--;                  // Decrement available copies of the book
-    borrower->books_borrowed.push_back(book);   // Add the book to the borrower's borrowed books
-    book->currentBorrowers.push_back(borrower);
-    book->allBorrowers.push_back(borrower);
+    issueBook(book, borrower);
 
     cout << "Book '" << bookTitle << "' has been issued to " << borrower->name << "." << endl;
 } 
@@ -419,28 +399,11 @@ void LCMS::returnBook(string bookTitle) {
     }
 
     // Check if the borrower has borrowed this book
-    bool found = false;
-    for (size_t i = 0; i < book->currentBorrowers.size(); i++) {
-        if (book->currentBorrowers[i] == borrower) {
-            found = true;
-            book->currentBorrowers.erase(i); // Remove the borrower
-            break;
-        }
-    }
-
-    if (!found) {
+    if (!receiveBook(book, borrower)) {
         cout << "This book was not borrowed by the specified borrower." << endl;
         return;
     }
 
-    // Removing book from borrower's list
-    book->available_copies++;
-    for (int i = 0; i > borrower->books_borrowed.size(); i++){
-        if (borrower->books_borrowed[i]->title == bookTitle) {
-            borrower->books_borrowed.erase(i);
-            break;
-    }}
-
     cout << "Book has been returned successfully." << endl;
 }
 
@@ -462,7 +425,7 @@ void LCMS::listAllBorrowers(string bookTitle) {
     Book* book = libTree->findBook(libTree->getRoot(), bookTitle);
     if (book) {
         for (int i = 0; i < book->allBorrowers.size(); i++){
-            cout << "1 "<< book->currentBorrowers[i]->name << "(" << book->currentBorrowers[i]->id << ")" << endl;
+            cout << "1 "<< book->allBorrowers[i]->name << "(" << book->allBorrowers[i]->id << ")" << endl;
         }
         cout << endl;
     }
@@ -508,48 +471,25 @@ void LCMS::addCategory(string category) {
         return;
     }
 
-    // Split category string by '/'
-    vector<string> categoryParts;
-    stringstream ss(category);
-    string part;
-    
-    while (getline(ss, part, '/')) {
-        categoryParts.push_back(part);
+    // "a//b" and "/a/" name the same category as "a/b" and "a", as they do for every lookup
+    if (Tree::normalizePath(category).empty()) {
+        cout << "Category name cannot be empty!" << endl;
+        return;
     }
 
-    // Start with the root node of the tree
-    Node* currentNode = libTree->getRoot();
-
-    // Traverse through each part of the category (e.g., "category/subcategory")
-    for (int i = 0; i < categoryParts.size(); ++i) {
-        bool found = false;
-
-        // Check if the current category part already exists in the current node's children
-        for (int j = 0; j < currentNode->children.size(); ++j) {
-            if (currentNode->children[j]->name == categoryParts[i]) {
-                currentNode = currentNode->children[j];  // Move to the child node
-                found = true;
-                break;
-            }
-        }
-
-        // If the category part is not found, create a new node for it
-        if (!found) {
-            Node* newCategoryNode = new Node(categoryParts[i]);
-            currentNode->children.push_back(newCategoryNode);
-            currentNode = newCategoryNode;  // Move to the new child node
-        }
-    }
+    // Create the missing parts of the path (e.g., "category/subcategory")
+    libTree->createNode(category);
 
     cout << "Category '" << category << "' added to the catalog." << endl;
 }
 
 
-// Find a category in the catalog
-void LCMS::findCategory(string category) {
-    Node* root = libTree->getRoot();
-    bool found = false;
+// Resolve a category given as a path (one index lookup), or else as a bare name anywhere in the catalog
+Node* LCMS::findCategoryNode(string category) {
+    Node* node = libTree->getNode(category);
+    if (node) return node;
 
+    Node* root = libTree->getRoot();
     // Create a vector to simulate a stack
     vector<Node*> stack;
     stack.push_back(root);
@@ -560,19 +500,21 @@ void LCMS::findCategory(string category) {
         stack.pop_back();  // Remove the last element
 
         // Check if the current node's name matches the category
-        if (currentNode->name == category) {
-            cout << "Category '" << category << "' was found in the catalog." << endl;
-            found = true;
-            break;
-        }
+        if (currentNode->name == category) return currentNode;
 
         // Add all children of the current node to the vector (simulating pushing onto the stack)
-        for (size_t i = 0; i < currentNode->children.size(); ++i) {
+        for (int i = 0; i < currentNode->children.size(); ++i) {
             stack.push_back(currentNode->children[i]);
         }
     }
+    return nullptr;
+}
 
-    if (!found) {
+// Find a category in the catalog
+void LCMS::findCategory(string category) {
+    if (findCategoryNode(category)) {
+        cout << "Category '" << category << "' was found in the catalog." << endl;
+    } else {
         cout << "No such Category/SubCategory was found in the catalog." << endl;
     }
 }
@@ -580,82 +522,27 @@ void LCMS::findCategory(string category) {
 
 // Remove a category and all it's books from the catalog
 void LCMS::removeCategory(string category) {
-    Node* root = libTree->getRoot();
-
-    // Create a vector to simulate a stack
-    vector<Node*> stack;
-    stack.push_back(root);
-
-    bool categoryFound = false;
-    Node* parentNode = nullptr;
-
-    while (!stack.empty()) {
-        Node* currentNode = stack.back();
-        stack.pop_back(); // Remove the last element (LIFO)
-
-        // Check if the current node's name matches the category
-        if (currentNode->name == category) {
-            categoryFound = true;
-            parentNode = currentNode->parent;
-            break;
-        }
-
-        // Add all children of the current node to the stack
-        for (size_t i = 0; i < currentNode->children.size(); ++i) {
-            stack.push_back(currentNode->children[i]);
-        }
-    }
-
-    if (!categoryFound) {
+    Node* categoryNode = findCategoryNode(category);
+    if (!categoryNode) {
         cout << "Category not found." << endl;
         return;
     }
 
-    // Remove the category from its parent's children vector
-    if (parentNode != nullptr) {
-        for (size_t i = 0; i < parentNode->children.size(); ++i) {
-            if (parentNode->children[i]->name == category) {
-                parentNode->children.erase(i);
-                cout << "Category '" << category << "' removed." << endl;
-                break;
-            }
-        }
+    // Remove the category from its parent; its books leave the title index and the counts with it.
+    // The subtree's count comes off its ancestors at once, so there is nothing to defer.
+    if (!libTree->isRoot(categoryNode)) {
+        libTree->remove(categoryNode->parent, categoryNode->name);
+        cout << "Category '" << category << "' removed." << endl;
     } else {
         cout << "Cannot remove the root category." << endl;
     }
 }
 
 
-// Edit a category in the catalog
 // Edit a category in the catalog
 void LCMS::editCategory(string category) {
-    // Get the root of the tree
-    Node* root = libTree->getRoot();
-
-    // Create a vector to simulate a stack for depth-first traversal
-    vector<Node*> stack;
-    stack.push_back(root);
-
-    bool categoryFound = false;
-    Node* currentNode = nullptr;
-
-    while (!stack.empty()) {
-        // Get the current node from the stack
-        currentNode = stack.back();
-        stack.pop_back(); // Remove the last element (LIFO)
-
-        // Check if the current node's name matches the category
-        if (currentNode->name == category) {
-            categoryFound = true;
-            break; // Category found, exit the loop
-        }
-
-        // Add all children of the current node to the stack
-        for (size_t i = 0; i < currentNode->children.size(); ++i) {
-            stack.push_back(currentNode->children[i]);
-        }
-    }
-    if (!categoryFound) {
+    Node* currentNode = findCategoryNode(category);
+    if (!currentNode) {
         cout << "Category not found." << endl;
         return;
     }
@@ -664,21 +551,260 @@ void LCMS::editCategory(string category) {
     cout << "Enter new category name: ";
     cin >> newCategoryName;
 
-    // Ensure the new category name is not empty or the same as the current name
-    if (newCategoryName.empty() || newCategoryName == category) {
+    // Ensure the new category name is one non-empty path segment and not the same as the current name
+    if (newCategoryName.empty() || newCategoryName.find('/') != string::npos || newCategoryName == currentNode->name) {
         cout << "Invalid category name." << endl;
         return;
     }
-    // Update the category name
-    currentNode->name = newCategoryName;
+    // Update the category name; the cached paths of its subtree follow
+    if (!libTree->renameNode(currentNode, newCategoryName)) {
+        cout << "A category named '" << newCategoryName << "' already exists there." << endl;
+        return;
+    }
     cout << "Category name updated to: " << newCategoryName << endl;
 }
 
 
 // Find a borrower by ID
 Borrower* LCMS::findBorrowerByID(string id) {
-    for (int i = 0; i < borrowers.size(); i++) {
-        if (borrowers[i]->id == id) return borrowers[i];
+    unordered_map<string, Borrower*>::iterator it = borrowerIndex.find(id);
+    return it == borrowerIndex.end() ? nullptr : it->second;
+}
+
+// Register a new borrower; pool slots never move, so the pointer stays valid as the list grows
+Borrower* LCMS::registerBorrower(string name, string id) {
+    Borrower* borrower = borrowerPool.create(name, id);
+    borrowers.push_back(borrower);
+    borrowerIndex[id] = borrower;
+    return borrower;
+}
+
+// Record a borrow on the book and on the borrower
+void LCMS::issueBook(Book* book, Borrower* borrower) {
+    book->available_copies--;                  // Decrement available copies of the book
+    borrower->books_borrowed.push_back(book);   // Add the book to the borrower's borrowed books
+    book->currentBorrowers.push_back(borrower);
+    book->allBorrowers.push_back(borrower);
+    libTree->syncBook(book);
+}
+
+// Record a return on the book and on the borrower
+bool LCMS::receiveBook(Book* book, Borrower* borrower) {
+    bool found = false;
+    for (int i = 0; i < book->currentBorrowers.size(); i++) {
+        if (book->currentBorrowers[i] == borrower) {
+            found = true;
+            book->currentBorrowers.erase(i); // Remove the borrower
+            break;
+        }
+    }
+    if (!found) return false;
+
+    // Removing book from borrower's list
+    book->available_copies++;
+    libTree->syncBook(book);
+    for (int i = 0; i < borrower->books_borrowed.size(); i++) {
+        if (borrower->books_borrowed[i] == book) {
+            borrower->books_borrowed.erase(i);
+            break;
+        }
+    }
+    return true;
+}
+
+// Split a query into terms at spaces outside double quotes; the quotes are dropped
+static vector<string> queryTerms(const string& text) {
+    vector<string> terms;
+    string term;
+    bool quoted = false, started = false;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '"') {
+            quoted = !quoted;
+            started = true;
+        } else if (text[i] == ' ' && !quoted) {
+            if (started) terms.push_back(term);
+            term.clear();
+            started = false;
+        } else {
+            term += text[i];
+            started = true;
+        }
+    }
+    if (started) terms.push_back(term);
+    return terms;
+}
+
+// Display the titles of the books matching every term. A term is field=value, field=low..high,
+// or field with <, <=, > or >=, over year, total and available; category=path limits the
+// search to a category and its sub-categories.
+void LCMS::query(string predicates) {
+    vector<string> terms = queryTerms(predicates);
+    if (terms.empty()) throw invalid_argument("query: expected terms such as year=1950..1970 available=0 category=Science");
+
+    vector<ColumnRange> ranges;
+    Node* category = nullptr;
+    for (size_t t = 0; t < terms.size(); t++) {
+        const string& term = terms[t];
+        size_t op = term.find_first_of("<>=");
+        if (op == string::npos) throw invalid_argument("query: missing operator in '" + term + "' (use =, a..b, <, <=, >, >=)");
+        int column = BookColumns::columnByName(term.substr(0, op));
+        if (column < 0) throw invalid_argument("query: unknown field in '" + term + "'");
+        size_t valueStart = op + 1;
+        if (valueStart < term.size() && term[valueStart] == '=') valueStart++;
+        string relation = term.substr(op, valueStart - op);
+        string value = term.substr(valueStart);
+
+        if (column == BookColumns::CATEGORY) {
+            if (relation != "=") throw invalid_argument("query: category only supports =");
+            category = findCategoryNode(value);
+            if (!category) {
+                cout << "Category '" << value << "' not found." << endl;
+                return;
+            }
+            continue;
+        }
+
+        // Bounds in long long so that < INT_MIN and > INT_MAX become empty ranges instead of wrapping
+        long long low = INT_MIN, high = INT_MAX;
+        int first, last;
+        size_t dots = value.find("..");
+        bool valid;
+        if ((relation == "=" || relation == "==") && dots != string::npos) {
+            valid = toInt(value.substr(0, dots), first) && toInt(value.substr(dots + 2), last);
+            low = first;
+            high = last;
+        } else {
+            valid = toInt(value, first);
+            if (relation == "=" || relation == "==") low = high = first;
+            else if (relation == "<=") high = first;
+            else if (relation == ">=") low = first;
+            else if (relation == "<") high = (long long)first - 1;
+            else if (relation == ">") low = (long long)first + 1;
+            else valid = false;
+        }
+        if (!valid) throw invalid_argument("query: invalid condition '" + term + "'");
+        ColumnRange range = {column, 1, 0};     // matches nothing
+        if (low <= high) {
+            range.low = (int)low;
+            range.high = (int)high;
+        }
+        ranges.push_back(range);
+    }
+
+    vector<Book*> matches;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int scanned = libTree->query(ranges, category, matches);
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    for (size_t i = 0; i < matches.size(); i++) {
+        cout << matches[i]->title << endl;
+    }
+    cout << matches.size() << " books found (" << scanned << " rows scanned in " << fixed << setprecision(2) << elapsed << " ms)" << endl;
+}
+
+// Resident set size of this process in MB, from /proc/self/statm
+static double residentMB() {
+    ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024.0) / 1024.0;
+}
+
+// Build a catalog shaped like a real one (many small categories, a few books each, some on loan)
+// in a separate tree, then report its memory, a full traversal and the teardown
+void LCMS::benchmarkCatalog(string bookCount) {
+    int n = bookCount.empty() ? 1000000 : stoi(bookCount);
+    if (n <= 0) throw invalid_argument("benchCatalog: the book count must be positive");
+    double before = residentMB();
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Tree* catalog = new Tree("Benchmark");
+    ObjectPool<Borrower> readerPool;
+    MyVector<Borrower*> readers;
+    for (int i = 0; i < max(1, n / 100); i++) {
+        readers.push_back(readerPool.create("Reader", to_string(i)));
+    }
+    catalog->beginBulk();
+    for (int i = 0; i < n; i++) {
+        int leaf = i / 3;   // three books per category, 16 sub-categories per parent
+        Node* node = catalog->createNode("C" + to_string(leaf / 256) + "/C" + to_string(leaf / 16 % 16) + "/C" + to_string(leaf % 16));
+        Book* book = catalog->createBook("Title " + to_string(i), "Author", "ISBN", 2000, 2, 2);
+        catalog->addBook(node, book);
+        if (i % 10 == 0) issueBook(book, readers[i / 10 % readers.size()]);
+    }
+    catalog->commitBulk();
+    double built = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    double resident = residentMB() - before;
+
+    // Visit every category, book and current borrower, five times over
+    start = chrono::steady_clock::now();
+    long long visited = 0;
+    for (int round = 0; round < 5; round++) {
+        vector<Node*> stack(1, catalog->getRoot());
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            for (int i = 0; i < node->books.size(); i++) {
+                Book* book = node->books[i];
+                visited += book->available_copies;
+                for (int j = 0; j < book->currentBorrowers.size(); j++) visited += book->currentBorrowers[j]->books_borrowed.size();
+            }
+            for (int i = 0; i < node->children.size(); i++) stack.push_back(node->children[i]);
+        }
+    }
+    double traversed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    delete catalog;
+    readerPool.clear();
+    double teardown = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(1);
+    cout << "Books:            " << n << " (checksum " << visited << ")" << endl;
+    cout << "Build:            " << built << " ms" << endl;
+    cout << "Resident memory:  " << resident << " MB (" << resident * 1048576 / n << " bytes/book)" << endl;
+    cout << "5 traversals:     " << traversed << " ms" << endl;
+    cout << "Teardown:         " << teardown << " ms" << endl;
+}
+
+// Time ID lookup + borrow + return as the number of registered borrowers grows tenfold each round
+void LCMS::benchmarkBorrowers(string maxCount) {
+    int limit = maxCount.empty() ? 1000000 : stoi(maxCount);
+    const int operations = 100000;
+    int existing = borrowers.size();
+    Book book("Benchmark", "", "", 2024, operations, operations);   // kept out of the catalog
+    mt19937 random(42);
+
+    cout << setw(12) << "Borrowers" << setw(18) << "ns/borrow+return" << endl;
+    for (int n = 1000; n <= limit; n *= 10) {
+        // Grow the registry with synthetic borrowers up to n
+        for (int i = borrowers.size() - existing; i < n; i++) {
+            string id = "bench-" + to_string(i);
+            if (!findBorrowerByID(id)) registerBorrower("Benchmark Borrower", id);
+        }
+        // Pick the IDs up front so only the lookups and the bookkeeping are timed
+        uniform_int_distribution<int> pick(0, n - 1);
+        vector<string> ids(operations);
+        for (int i = 0; i < operations; i++) {
+            ids[i] = "bench-" + to_string(pick(random));
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < operations; i++) {
+            Borrower* borrower = findBorrowerByID(ids[i]);
+            issueBook(&book, borrower);
+            receiveBook(&book, borrower);
+        }
+        double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout << setw(12) << n << setw(18) << fixed << setprecision(1) << elapsed / operations << endl;
+        if (n > limit / 10) break;
+    }
+
+    // Drop the synthetic borrowers again; they were appended after the real ones
+    while (borrowers.size() > existing) {
+        Borrower* borrower = borrowers.back();
+        borrowerIndex.erase(borrower->id);
+        borrowerPool.destroy(borrower);
+        borrowers.erase(borrowers.size() - 1);
     }
-    return nullptr;
 }
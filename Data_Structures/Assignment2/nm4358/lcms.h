@@ -9,16 +9,23 @@
 #ifndef _LCMS_H
 #define _LCMS_H
 #include<string>
+#include<unordered_map>
 #include "tree.h"
 #include "myvector.h"
 #include "borrower.h"
+#include "pool.h"
 //#include "book.h"
 
 class LCMS
 {
 	private:
 		Tree *libTree;	//Tree of Categories and books
+		ObjectPool<Borrower> borrowerPool;	//storage of all borrowers, released in bulk with the LCMS
 		MyVector<Borrower*> borrowers; //list of borrowers that have ever borrowed a book	
+		unordered_map<string, Borrower*> borrowerIndex;	//borrower ID -> borrower, the same objects as in borrowers
+		Borrower* registerBorrower(string name, string id);	//create a borrower and index it by ID
+		void issueBook(Book* book, Borrower* borrower);		//record a borrow on both sides
+		bool receiveBook(Book* book, Borrower* borrower);	//record a return, false if the borrower does not have the book
 	public:
 		LCMS(string name);
 		~LCMS();
@@ -27,6 +34,9 @@ class LCMS
 		void exportData(string path); //export all books to a given file
 		void findAll(string category); //display all books of a category
 		void findBook(string bookTitle); //Find a given book and display its details
+		void findByISBN(string isbn); //Find the books with an ISBN and display their details
+		void findByAuthor(string author); //List the books of an author
+		void searchTitle(string words); //List the books with all the words in their title, best matches first
 		void addBook();	//add a book to the catalog
 		void editBook(string bookTitle); //edit a book
 		void borrowBook(string bookTitle); //borrow a book
@@ -45,5 +55,9 @@ class LCMS
 		}
 		// Extra
 		Borrower* findBorrowerByID(string id);
+		Node* findCategoryNode(string category);	//category by path, falling back to a search by name
+		void benchmarkBorrowers(string maxCount);	//time borrow/return against a growing number of borrowers
+		void benchmarkCatalog(string bookCount);	//memory and traversal time of a synthetic catalog
+		void query(string predicates);				//list the books matching e.g. year=1950..1970 available=0 category=Science
 };
 #endif
\ No newline at end of file
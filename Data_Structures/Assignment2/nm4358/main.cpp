@@ -8,6 +8,7 @@
 //============================================================================
 #include<iostream>
 #include "lcms.h"
+#include "vectorbench.h"
 using namespace std;
 
 void listCommands();
@@ -39,6 +40,9 @@ int main()
 			else if(command=="list")			lcms.list();
 			else if(command=="findAll")     	lcms.findAll(parameter);
 			else if(command=="findBook")		lcms.findBook(parameter);
+			else if(command=="findByISBN")		lcms.findByISBN(parameter);
+			else if(command=="findByAuthor")	lcms.findByAuthor(parameter);
+			else if(command=="searchTitle")		lcms.searchTitle(parameter);
 			else if(command=="addBook") 		lcms.addBook();
 			else if(command=="editBook")		lcms.editBook(parameter);
 			else if(command=="borrowBook")      lcms.borrowBook(parameter);
@@ -50,6 +54,11 @@ int main()
 			else if(command=="findCategory")    lcms.findCategory(parameter);
 			else if(command=="addCategory")    lcms.addCategory(parameter);
 			else if(command=="removeCategory")  lcms.removeCategory(parameter);
+			else if(command=="editCategory")    lcms.editCategory(parameter);
+			else if(command=="query")           lcms.query(parameter);
+			else if(command=="benchBorrowers")  lcms.benchmarkBorrowers(parameter);
+			else if(command=="benchVector")     benchmarkVectors(parameter);
+			else if(command=="benchCatalog")    lcms.benchmarkCatalog(parameter);
 			else if(command == "help")			listCommands();
 			else if(command == "exit")			break;
 			else 								cout<<"Invalid Command!"<<endl;
@@ -72,6 +81,9 @@ void listCommands()
 		<<" import <file_name>                          : Read a Book file from a file"<<endl
 		<<" export <file_name>                          : Export Books to a file"<<endl
 		<<" findBook <title of the book>                : Search a book in the catalog"<<endl
+		<<" findByISBN <isbn>                           : Search books by ISBN-10 or ISBN-13"<<endl
+		<<" findByAuthor <author>                       : List all books of an author"<<endl
+		<<" searchTitle <words>                         : Search books by words of their title, best matches first"<<endl
 		<<" findAll <category/sub-category/..>          : List all books in a category/sub-category"<<endl
 		<<" addBook                                     : Add a book to the Catalog"<<endl
 		<<" editBook <title of the book>                : Edit a book detail in the catalog"<<endl
@@ -84,8 +96,12 @@ void listCommands()
 		<<" findCategory                                : Find a category in the catalog"<<endl
 		<<" addCategory <category/sub-category/...>     : Add a category/sub-category to the catalog"<<endl
 		<<" removeCategory <category/sub-category/...>  : Remove a category/sub-category from the catalog"<<endl
-		//<<" editCategory <category/sub-category/...>    : Edit a category/sub-category"<<endl
+		<<" editCategory <category/sub-category/...>    : Edit a category/sub-category"<<endl
 		<<" list                                        : Display all categories from the catalog"<<endl
+		<<" query <field op value> ...                  : List books by year/total/available (=, a..b, <, <=, >, >=) and category=path"<<endl
+		<<" benchBorrowers [max borrowers]              : Time borrow/return from 1K up to max borrowers (default 1M)"<<endl
+		<<" benchVector [elements]                      : Compare MyVector with std::vector (default 10M elements)"<<endl
+		<<" benchCatalog [books]                        : Memory and traversal time of a synthetic catalog (default 1M books)"<<endl
 		<<" help                                        : Display the list of available commands"<<endl
 		<<" exit                                        : Exit the Program"<<endl
 		<<" ====================================================================================\n"<<endl;	
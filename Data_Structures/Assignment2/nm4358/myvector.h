@@ -3,7 +3,7 @@
 // Author       : Nikhil Mundhra
 // Version      : 1.0
 // Date Created : 5 Nov
-// Date Modified: 6 Nov
+// Date Modified: 19 Oct
 // Description  : Vector implementation in C++
 //============================================================================
 #ifndef MYVECTOR_H
@@ -13,195 +13,374 @@
 #include<iomanip>
 #include <stdexcept>
 #include<sstream>
+#include <new>
+#include <utility>
 
-using namespace std;
+// operator[] checks its index unless the program is built with -DMYVECTOR_CHECKED=0;
+// at() always checks. A vector can also pick its policy with the second template argument.
+#ifndef MYVECTOR_CHECKED
+#define MYVECTOR_CHECKED 1
+#endif
+
+// Room for N elements inside the vector object itself; empty (and free, as a base class) for N = 0
+template <typename T, int N>
+struct InlineSlots
+{
+	alignas(T) unsigned char bytes[N * sizeof(T)];
+	T* slots() { return reinterpret_cast<T*>(bytes); }
+};
 template <typename T>
-class MyVector
+struct InlineSlots<T, 0>
+{
+	T* slots() { return nullptr; }
+};
+
+using namespace std;
+// With Inline > 0 the first Inline elements live inside the vector and the heap is only used
+// beyond that; see SmallVector below.
+template <typename T, bool Checked = MYVECTOR_CHECKED, int Inline = 0>
+class MyVector : private InlineSlots<T, Inline>
 {
 	private:
-		T *data;						//pointer to int(array) to store elements
+		T *data;						//storage for v_capacity elements, only the first v_size are constructed
 		int v_size;						//current size of vector (number of elements in vector)
 		int v_capacity;					//capacity of vector
+		static T* allocate(int cap);	//raw heap storage, no elements constructed
+		void release();					//free data unless it is the inline slots
+		void reallocate(int cap);		//move the elements into new storage of capacity cap
+		int grown() const;				//capacity to grow to when the vector is full
+		void take(MyVector& other);		//move other's elements or heap block into this empty vector
 	public:
+		typedef T* iterator;			//plain pointers work with the standard algorithms
+		typedef const T* const_iterator;
+
 		MyVector();						//No argument constructor
-		MyVector(int cap);				//One Argument Constructor
+		MyVector(int cap);				//One Argument Constructor, reserves cap elements
 		MyVector(const MyVector& other);		//Copy Constructor
+		MyVector(MyVector&& other) noexcept;	//Move Constructor, leaves other empty
+		MyVector& operator=(const MyVector& other);		//Copy Assignment
+		MyVector& operator=(MyVector&& other) noexcept;	//Move Assignment
 		~MyVector();					//Destructor
-		void push_back(T element);		//Add an element at the end of vector
-		void insert(int index, T element); //Add an element at the index 
+		void push_back(const T& element);	//Add an element at the end of vector
+		void push_back(T&& element);		//Add an element at the end of vector, moving it in
+		template <typename... Args>
+		T& emplace_back(Args&&... args);	//Construct an element in place at the end of vector
+		void insert(int index, T element); //Add an element at the index
 		void erase(int index);			//Removes an element from the index
-		T& operator[](int index);		//return reference of the element at index
-		T& at(int index); 				//return reference of the element at index
+		void pop_back();				//Removes the last element
+		void clear();					//Removes all elements, keeps the capacity
+		void reserve(int cap);			//Make room for at least cap elements
+		T& operator[](int index);		//return reference of the element at index (checked if Checked)
+		const T& operator[](int index) const;
+		T& at(int index); 				//return reference of the element at index (always checked)
 		const T& front();				//Returns reference of the first element in the vector
 		const T& back();				//Returns reference of the Last element in the vector
 		int size() const;				//Return current size of vector
 		int capacity() const;			//Return capacity of vector
 		bool empty() const; 			//Return true if the vector is empty, False otherwise
 		void shrink_to_fit();			//Reduce vector capacity to fit its size
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
 };
+
+// MyVector that keeps up to N elements inline, for members that usually hold only a few
+template <typename T, int N>
+using SmallVector = MyVector<T, MYVECTOR_CHECKED, N>;
 //========================================
-template <typename T>
-MyVector<T>::MyVector()
+template <typename T, bool Checked, int Inline>
+T* MyVector<T, Checked, Inline>::allocate(int cap)
 {
-	//to-do
-	data = nullptr;
-	v_size = 0;
-	v_capacity = 0;
+	return cap == 0 ? nullptr : static_cast<T*>(::operator new(sizeof(T) * cap));
 }
 //========================================
-template <typename T>
-MyVector<T>::MyVector(int cap)
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::release()
 {
-	//to-do
-	v_size = 0;
-	v_capacity = cap;
-	data = new T[v_capacity];
+	if (data != this->slots()) ::operator delete(data);
 }
 //========================================
-template <typename T>
-MyVector<T>::MyVector(const MyVector &other) : v_size(other.v_size), v_capacity(other.v_capacity) 
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::reallocate(int cap)
+{
+	// Anything that fits goes back into the inline slots
+	T *new_data = (cap <= Inline) ? this->slots() : allocate(cap);
+	if (new_data == data) return;
+	for (int i = 0; i < v_size; ++i) {
+		new (new_data + i) T(std::move_if_noexcept(data[i]));	//move unless that could throw halfway
+		data[i].~T();
+	}
+	release();
+	data = new_data;
+	v_capacity = (cap <= Inline) ? Inline : cap;
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::take(MyVector &other)
+{
+	if (other.data == other.slots()) {
+		// Inline elements cannot be handed over, they are moved one by one
+		for (; v_size < other.v_size; ++v_size) {
+			new (data + v_size) T(std::move(other.data[v_size]));
+		}
+		other.clear();
+		return;
+	}
+	data = other.data;
+	v_size = other.v_size;
+	v_capacity = other.v_capacity;
+	other.data = other.slots();
+	other.v_size = 0;
+	other.v_capacity = Inline;
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+int MyVector<T, Checked, Inline>::grown() const
+{
+	return (v_capacity == 0) ? 1 : v_capacity * 2;
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>::MyVector() : data(this->slots()), v_size(0), v_capacity(Inline)
 {
-	//to-do
-    data = new T[v_capacity];
-    for (int i = 0; i < v_size; ++i) {
-        data[i] = other.data[i];
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>::MyVector(int cap) : data(this->slots()), v_size(0), v_capacity(Inline)
+{
+	reserve(cap);
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>::MyVector(const MyVector &other) : data(this->slots()), v_size(0), v_capacity(Inline)
+{
+    reserve(other.v_size);
+    for (; v_size < other.v_size; ++v_size) {
+        new (data + v_size) T(other.data[v_size]);
     }
 }
 //========================================
-template <typename T>
-MyVector<T>::~MyVector()
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>::MyVector(MyVector &&other) noexcept : data(this->slots()), v_size(0), v_capacity(Inline)
 {
-	//to-do
-	delete[] data;
+	take(other);
 }
 //========================================
-template <typename T>
-int MyVector<T>::size() const
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>& MyVector<T, Checked, Inline>::operator=(const MyVector &other)
+{
+	if (this != &other) {
+		MyVector copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>& MyVector<T, Checked, Inline>::operator=(MyVector &&other) noexcept
+{
+	if (this != &other) {
+		clear();
+		release();
+		data = this->slots();
+		v_capacity = Inline;
+		take(other);
+	}
+	return *this;
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+MyVector<T, Checked, Inline>::~MyVector()
+{
+	clear();
+	release();
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+int MyVector<T, Checked, Inline>::size() const
 {
-	//to-do
 	return v_size;
 }
 //========================================
-template <typename T>
-int MyVector<T>::capacity() const
+template <typename T, bool Checked, int Inline>
+int MyVector<T, Checked, Inline>::capacity() const
 {
-	//to-do
 	return v_capacity;
 }
 //========================================
-template <typename T>
-bool MyVector<T>::empty() const
+template <typename T, bool Checked, int Inline>
+bool MyVector<T, Checked, Inline>::empty() const
 {
-	//to-do
 	return v_size == 0;
 }
 //========================================
-template <typename T>
-void MyVector<T>::push_back(T element)
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::push_back(const T& element)
+{
+	emplace_back(element);
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::push_back(T&& element)
+{
+	emplace_back(std::move(element));
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+template <typename... Args>
+T& MyVector<T, Checked, Inline>::emplace_back(Args&&... args)
 {
-
-	//to-do
 	if (v_size == v_capacity) {
-        v_capacity = (v_capacity == 0) ? 1 : v_capacity * 2;
-        T *new_data = new T[v_capacity];
-        for (int i = 0; i < v_size; ++i) {
-            new_data[i] = data[i];
-        }
-        delete[] data;
-        data = new_data;
-    }
-    data[v_size++] = element;
+		// Build the new element before moving the old ones: args may refer to one of them
+		int new_capacity = grown();
+		T *new_data = allocate(new_capacity);
+		try {
+			new (new_data + v_size) T(std::forward<Args>(args)...);
+		} catch (...) {
+			::operator delete(new_data);
+			throw;
+		}
+		for (int i = 0; i < v_size; ++i) {
+			new (new_data + i) T(std::move_if_noexcept(data[i]));
+			data[i].~T();
+		}
+		release();
+		data = new_data;
+		v_capacity = new_capacity;
+	} else {
+		new (data + v_size) T(std::forward<Args>(args)...);
+	}
+	return data[v_size++];
 }
 //===============================================================================
-template <typename T>	
-void MyVector<T>::insert(int index,T element)
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::insert(int index,T element)
 {
-
-	//to-do
 	if (index < 0 || index > v_size) {
         throw out_of_range("Index out of range");
     }
-    if (v_size == v_capacity) {
-        v_capacity = (v_capacity == 0) ? 1 : v_capacity * 2;
-        T *new_data = new T[v_capacity];
-        for (int i = 0; i < v_size; ++i) {
-            new_data[i] = data[i];
-        }
-        delete[] data;
-        data = new_data;
+    if (index == v_size) {
+        emplace_back(std::move(element));
+        return;
     }
-    for (int i = v_size; i > index; --i) {
-        data[i] = data[i - 1];
+    if (v_size == v_capacity) reallocate(grown());
+    // Shift the tail up by one, moving rather than copying
+    new (data + v_size) T(std::move(data[v_size - 1]));
+    for (int i = v_size - 1; i > index; --i) {
+        data[i] = std::move(data[i - 1]);
     }
-    data[index] = element;
+    data[index] = std::move(element);
     v_size++;
 }
 //================================================================================
-template <typename T>	
-void MyVector<T>::erase(int index)
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::erase(int index)
 {
-	//to-do
 	if (index < 0 || index >= v_size) {
         throw out_of_range("Index out of range");
     }
     for (int i = index; i < v_size - 1; ++i) {
-        data[i] = data[i + 1];
+        data[i] = std::move(data[i + 1]);
     }
-    v_size--;
+    data[--v_size].~T();
+}
+//================================================================================
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::pop_back()
+{
+	if (empty()) {
+		throw out_of_range("Vector is empty");
+	}
+	data[--v_size].~T();
+}
+//================================================================================
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::clear()
+{
+	while (v_size > 0) {
+		data[--v_size].~T();
+	}
+}
+//================================================================================
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::reserve(int cap)
+{
+	if (cap > v_capacity) reallocate(cap);
 }
 //==================================================================================
-template <typename T>
-T& MyVector<T>::operator[](int index)
+template <typename T, bool Checked, int Inline>
+T& MyVector<T, Checked, Inline>::operator[](int index)
 {
-		//to-do
-		if (index < 0 || index >= v_size) {
+		if (Checked && (index < 0 || index >= v_size)) {
         	throw out_of_range("Index out of bounds");
     	}
 		return data[index];
 }
 //========================================
-template <typename T>
-T& MyVector<T>::at(int index)
+template <typename T, bool Checked, int Inline>
+const T& MyVector<T, Checked, Inline>::operator[](int index) const
+{
+		if (Checked && (index < 0 || index >= v_size)) {
+        	throw out_of_range("Index out of bounds");
+    	}
+		return data[index];
+}
+//========================================
+template <typename T, bool Checked, int Inline>
+T& MyVector<T, Checked, Inline>::at(int index)
 {
-		//to-do
 		if (index < 0 || index >= v_size) {
         	throw out_of_range("Index out of range");
 		}
 		return data[index];
 }
 //========================================
-template <typename T>
-const T& MyVector<T>::front()
+template <typename T, bool Checked, int Inline>
+const T& MyVector<T, Checked, Inline>::front()
 {
-		//to-do
 		if (empty()) {
         	throw out_of_range("Vector is empty");
 		}
 		return data[0];
 }
 //========================================
-template <typename T>
-const T& MyVector<T>::back()
+template <typename T, bool Checked, int Inline>
+const T& MyVector<T, Checked, Inline>::back()
 {
-		//to-do
 		if (empty()) {
         	throw out_of_range("Vector is empty");
 		}
 		return data[v_size-1];
 }
 //======================================
-template <typename T>
-void MyVector<T>::shrink_to_fit()		//Reduce vector capacity to fit its size.
-{
-		//to-do
-		if (v_capacity > v_size) {
-			v_capacity = v_size;
-			T *new_data = new T[v_capacity];
-			for (int i = 0; i < v_size; ++i) {
-				new_data[i] = data[i];
-			}
-			delete[] data;
-			data = new_data;
-    }
+template <typename T, bool Checked, int Inline>
+void MyVector<T, Checked, Inline>::shrink_to_fit()		//Reduce vector capacity to fit its size.
+{
+		if (v_capacity > v_size) reallocate(v_size);
+}
+//======================================
+template <typename T, bool Checked, int Inline>
+typename MyVector<T, Checked, Inline>::iterator MyVector<T, Checked, Inline>::begin()
+{
+	return data;
+}
+//======================================
+template <typename T, bool Checked, int Inline>
+typename MyVector<T, Checked, Inline>::iterator MyVector<T, Checked, Inline>::end()
+{
+	return data + v_size;
+}
+//======================================
+template <typename T, bool Checked, int Inline>
+typename MyVector<T, Checked, Inline>::const_iterator MyVector<T, Checked, Inline>::begin() const
+{
+	return data;
+}
+//======================================
+template <typename T, bool Checked, int Inline>
+typename MyVector<T, Checked, Inline>::const_iterator MyVector<T, Checked, Inline>::end() const
+{
+	return data + v_size;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,159 @@
+//============================================================================
+// Name         : pool.h
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Typed object pool (slab allocator with a free list) for catalog objects
+//============================================================================
+#ifndef _POOL_H
+#define _POOL_H
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Objects are carved out of slabs of about 32 KB in creation order, so things created together
+// (the books of an import, the children of a category) sit next to each other. destroy() puts a
+// slot on a free list for the next create(); clear() and the destructor destroy whatever is still
+// alive slab by slab and return the slabs to the heap, without following any pointers.
+template <typename T>
+class ObjectPool
+{
+	private:
+		struct Slot
+		{
+			alignas(T) unsigned char storage[sizeof(T)];	//the object, or the free list link while unused
+			bool live;										//storage holds a constructed object
+		};
+		// Slabs stay under 64 KB: glibc consolidates every free small chunk whenever a block that size is freed
+		static const int SLAB_SLOTS = sizeof(Slot) * 16 > 32768 ? 16 : 32768 / sizeof(Slot);
+		std::vector<Slot*> slabs;	//every slab holds SLAB_SLOTS slots
+		Slot* freeList;				//unused slots, most recently freed first
+		int used;					//slots handed out from the last slab
+		int count;					//live objects
+		static Slot*& next(Slot* slot);	//free list link, kept inside the unused storage
+		Slot* acquire();				//a free slot, from the free list or the last slab
+
+	public:
+		ObjectPool();
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+		~ObjectPool();					//destroys the remaining objects and frees all slabs
+		template <typename... Args>
+		T* create(Args&&... args);		//construct an object in a pool slot
+		void destroy(T* object);		//destroy an object created by this pool and reuse its slot
+		void adopt(ObjectPool& other);	//take over other's objects and slabs, leaving other empty
+		void clear();					//destroy every object and free all slabs
+		int size() const;				//number of live objects
+};
+//======================================
+template <typename T>
+ObjectPool<T>::ObjectPool() : freeList(nullptr), used(SLAB_SLOTS), count(0) {}
+//======================================
+template <typename T>
+ObjectPool<T>::~ObjectPool()
+{
+	clear();
+}
+//======================================
+template <typename T>
+typename ObjectPool<T>::Slot*& ObjectPool<T>::next(Slot* slot)
+{
+	return *reinterpret_cast<Slot**>(slot->storage);
+}
+//======================================
+template <typename T>
+typename ObjectPool<T>::Slot* ObjectPool<T>::acquire()
+{
+	if (freeList) {
+		Slot* slot = freeList;
+		freeList = next(slot);
+		return slot;
+	}
+	if (used == SLAB_SLOTS) {
+		Slot* slab = static_cast<Slot*>(malloc(sizeof(Slot) * SLAB_SLOTS));
+		if (!slab) throw std::bad_alloc();
+		slabs.push_back(slab);
+		used = 0;
+		for (int i = 0; i < SLAB_SLOTS; i++) slab[i].live = false;
+	}
+	return &slabs.back()[used++];
+}
+//======================================
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::create(Args&&... args)
+{
+	Slot* slot = acquire();
+	T* object;
+	try {
+		object = new (slot->storage) T(std::forward<Args>(args)...);
+	} catch (...) {
+		next(slot) = freeList;
+		freeList = slot;
+		throw;
+	}
+	slot->live = true;
+	count++;
+	return object;
+}
+//======================================
+template <typename T>
+void ObjectPool<T>::destroy(T* object)
+{
+	if (object == nullptr) return;
+	Slot* slot = reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(object) - offsetof(Slot, storage));
+	object->~T();
+	slot->live = false;
+	next(slot) = freeList;
+	freeList = slot;
+	count--;
+}
+//======================================
+template <typename T>
+void ObjectPool<T>::adopt(ObjectPool& other)
+{
+	if (&other == this || other.slabs.empty()) return;
+	// other's untouched slots join its free list, then its slabs go before our last (partly used) one
+	while (other.used < SLAB_SLOTS) {
+		Slot* slot = &other.slabs.back()[other.used++];
+		next(slot) = other.freeList;
+		other.freeList = slot;
+	}
+	if (other.freeList) {
+		Slot* last = other.freeList;
+		while (next(last)) last = next(last);
+		next(last) = freeList;
+		freeList = other.freeList;
+	}
+	if (slabs.empty()) used = SLAB_SLOTS;
+	slabs.insert(slabs.empty() ? slabs.end() : slabs.end() - 1, other.slabs.begin(), other.slabs.end());
+	count += other.count;
+	other.slabs.clear();
+	other.freeList = nullptr;
+	other.count = 0;
+}
+//======================================
+template <typename T>
+void ObjectPool<T>::clear()
+{
+	for (size_t s = 0; s < slabs.size(); s++) {
+		for (int i = 0; i < SLAB_SLOTS; i++) {		// slots never handed out are not live either
+			if (slabs[s][i].live) reinterpret_cast<T*>(slabs[s][i].storage)->~T();
+		}
+		free(slabs[s]);
+	}
+	slabs.clear();
+	freeList = nullptr;
+	used = SLAB_SLOTS;
+	count = 0;
+}
+//======================================
+template <typename T>
+int ObjectPool<T>::size() const
+{
+	return count;
+}
+#endif
@@ -0,0 +1,159 @@
+//============================================================================
+// Name         : titlesearch.cpp
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Inverted index from title words to books, for searches by words of a title
+//============================================================================
+
+#include "titlesearch.h"
+#include "book.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <utility>
+
+using namespace std;
+
+TitleSearch::TitleSearch() : built(false), live(0) {}
+
+// Build the word starting at text[i] into word and return the index after it; word is empty at the end of text
+static size_t nextWord(const string& text, size_t i, string& word) {
+    word.clear();
+    for (; i < text.size(); i++) {
+        unsigned char c = text[i];
+        if (isalnum(c) || c >= 0x80) {      // bytes of UTF-8 characters stay part of the word
+            word += (char)tolower(c);
+        } else if (c == '\'' && !word.empty()) {
+            continue;
+        } else if (!word.empty()) {
+            break;
+        }
+    }
+    return i;
+}
+
+vector<string> TitleSearch::words(const string& text) {
+    vector<string> result;
+    string word;
+    for (size_t i = nextWord(text, 0, word); !word.empty(); i = nextWord(text, i, word)) {
+        result.push_back(word);
+    }
+    return result;
+}
+
+// Sum of the weights of the title's words that are search terms, over the number of words in the
+// title. word is scratch space shared by all calls, so scoring does not allocate.
+double TitleSearch::score(const string& title, const vector<pair<string, double> >& weights, string& word) {
+    double sum = 0;
+    int count = 0;
+    for (size_t i = nextWord(title, 0, word); !word.empty(); i = nextWord(title, i, word)) {
+        count++;
+        for (size_t w = 0; w < weights.size(); w++) {
+            if (weights[w].first == word) sum += weights[w].second;
+        }
+    }
+    return count == 0 ? 0 : sum / count;
+}
+
+void TitleSearch::add(Book* book) {
+    if (book->searchId < 0) {
+        book->searchId = books.size();
+        books.push_back(book);
+    } else {
+        books[book->searchId] = book;
+    }
+    live++;
+    if (built) post(book);
+}
+
+void TitleSearch::remove(Book* book) {
+    if (book->searchId < 0 || books[book->searchId] != book) return;
+    if (built) unpost(book);
+    books[book->searchId] = nullptr;
+    live--;
+}
+
+// New books have the highest ID so far and go at the end; a re-added (edited) book is inserted in order
+void TitleSearch::post(Book* book) {
+    unsigned int id = book->searchId;
+    string word;
+    for (size_t i = nextWord(book->title, 0, word); !word.empty(); i = nextWord(book->title, i, word)) {
+        vector<unsigned int>& list = postings[word];
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+        } else {
+            vector<unsigned int>::iterator it = lower_bound(list.begin(), list.end(), id);
+            if (*it != id) list.insert(it, id);     // a word may occur twice in a title
+        }
+    }
+}
+
+void TitleSearch::unpost(Book* book) {
+    unsigned int id = book->searchId;
+    string word;
+    for (size_t i = nextWord(book->title, 0, word); !word.empty(); i = nextWord(book->title, i, word)) {
+        unordered_map<string, vector<unsigned int> >::iterator entry = postings.find(word);
+        if (entry == postings.end()) continue;
+        vector<unsigned int>& list = entry->second;
+        vector<unsigned int>::iterator it = lower_bound(list.begin(), list.end(), id);
+        if (it != list.end() && *it == id) list.erase(it);
+        if (list.empty()) postings.erase(entry);
+    }
+}
+
+// ids is the shorter list: for each of its IDs, gallop ahead in list (1, 2, 4, ... steps) and
+// binary search the last step, so the cost grows with the short list and only logarithmically with the long one
+void TitleSearch::intersect(vector<unsigned int>& ids, const vector<unsigned int>& list) {
+    size_t kept = 0, low = 0, n = list.size();
+    for (size_t i = 0; i < ids.size() && low < n; i++) {
+        unsigned int id = ids[i];
+        size_t bound = 1;
+        while (low + bound < n && list[low + bound] < id) bound *= 2;
+        low = lower_bound(list.begin() + low + bound / 2, list.begin() + min(low + bound + 1, n), id) - list.begin();
+        if (low < n && list[low] == id) ids[kept++] = id;
+    }
+    ids.resize(kept);
+}
+
+vector<Book*> TitleSearch::search(const string& text) {
+    if (!built) {
+        built = true;
+        for (size_t id = 0; id < books.size(); id++) {
+            if (books[id]) post(books[id]);
+        }
+    }
+
+    vector<string> terms = words(text);
+    sort(terms.begin(), terms.end());
+    terms.erase(unique(terms.begin(), terms.end()), terms.end());
+    vector<Book*> result;
+    if (terms.empty()) return result;
+
+    // Intersect the shortest lists first, which keeps the running result small
+    vector<pair<size_t, const vector<unsigned int>*> > lists;
+    for (size_t t = 0; t < terms.size(); t++) {
+        unordered_map<string, vector<unsigned int> >::const_iterator entry = postings.find(terms[t]);
+        if (entry == postings.end()) return result;
+        lists.push_back(make_pair(entry->second.size(), &entry->second));
+    }
+    sort(lists.begin(), lists.end());
+    vector<unsigned int> ids(*lists[0].second);
+    for (size_t l = 1; l < lists.size() && !ids.empty(); l++) intersect(ids, *lists[l].second);
+
+    // Rank by the idf of the terms, counted as often as they occur, over the length of the title
+    vector<pair<string, double> > idf;
+    for (size_t t = 0; t < terms.size(); t++) {
+        idf.push_back(make_pair(terms[t], log(1.0 + (double)live / postings.find(terms[t])->second.size())));
+    }
+    vector<pair<double, unsigned int> > ranked;
+    ranked.reserve(ids.size());
+    string word;
+    for (size_t i = 0; i < ids.size(); i++) {
+        ranked.push_back(make_pair(-score(books[ids[i]]->title, idf, word), ids[i]));   // ties keep the order of addition
+    }
+    sort(ranked.begin(), ranked.end());
+    for (size_t i = 0; i < ranked.size(); i++) result.push_back(books[ranked[i].second]);
+    return result;
+}
@@ -0,0 +1,43 @@
+//============================================================================
+// Name         : titlesearch.h
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Inverted index from title words to books, for searches by words of a title
+//============================================================================
+#ifndef _TITLESEARCH_H
+#define _TITLESEARCH_H
+#include<string>
+#include<unordered_map>
+#include<utility>
+#include<vector>
+using namespace std;
+class Book;
+
+// Every book gets a small ID the first time it is added; a word maps to the sorted IDs of the
+// books whose title contains it. The postings are only built by the first search, and kept up to
+// date from then on, so catalogs that are never searched do not pay for them.
+class TitleSearch
+{
+	private:
+		vector<Book*> books;							//ID -> book, nullptr once removed
+		unordered_map<string, vector<unsigned int> > postings;	//word -> IDs of the books with it in their title, ascending
+		bool built;										//postings exist and are maintained
+		int live;										//books currently added
+		void post(Book* book);							//add a book's ID to the postings of its words
+		void unpost(Book* book);						//drop a book's ID from the postings of its words
+		static void intersect(vector<unsigned int>& ids, const vector<unsigned int>& list);	//keep the ids also in list
+		static double score(const string& title, const vector<pair<string, double> >& weights, string& word);	//see search
+
+	public:
+		TitleSearch();
+		// Lower-case runs of letters and digits; apostrophes are dropped, so "Hitchhiker's" is "hitchhikers"
+		static vector<string> words(const string& text);
+		void add(Book* book);		//index a book, giving it an ID if it has none
+		void remove(Book* book);	//forget a book; it keeps its ID for when it is added again
+		// Books whose title has every word of text, the best first: each word counts by its rarity
+		// (idf) and by how much of the title it makes up
+		vector<Book*> search(const string& text);
+};
+#endif
@@ -9,40 +9,139 @@
 
 #include "tree.h"
 #include "book.h"
+#include "borrower.h"
 #include "myvector.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <thread>
+#include "csvreader.h"
 
 using namespace std;
 
 // Node constructor
-Node::Node(string name) : name(name), bookCount(0), parent(nullptr) {}
+Node::Node(string name) : name(name), bookCount(0), pendingCount(0), parent(nullptr), id(0), path(nullptr), childMap(nullptr) {}
 
-// Node destructor
+// Node destructor; the tree's pools own the children and books
 Node::~Node() {
-    for (int i = 0; i < children.size(); i++) {
-        delete children[i];
+    delete childMap;
+}
+
+// Orders children by name; ties keep the order they were added in
+bool Node::nameBefore(Node* child, const string& name) {
+    return child->name < name;
+}
+
+// Find the first child with a given name through the child index
+Node* Node::findChild(const string& childname) {
+    if (childMap) {
+        unordered_map<string, Node*>::iterator it = childMap->find(childname);
+        return it == childMap->end() ? nullptr : it->second;
     }
-    for (int i = 0; i < books.size(); i++) {
-        delete books[i];
+    vector<Node*>::iterator it = lower_bound(sortedChildren.begin(), sortedChildren.end(), childname, nameBefore);
+    return (it != sortedChildren.end() && (*it)->name == childname) ? *it : nullptr;
+}
+
+// Add a newly appended child to the index, switching to a hash map once there are many children
+void Node::indexChild(Node* child) {
+    if (!childMap && children.size() > CHILD_MAP_THRESHOLD) {
+        childMap = new unordered_map<string, Node*>();
+        for (int i = 0; i < children.size(); i++) {
+            childMap->insert(make_pair(children[i]->name, children[i]));   // keeps the first of equal names
+        }
+        vector<Node*>().swap(sortedChildren);
+        return;
+    }
+    if (childMap) {
+        childMap->insert(make_pair(child->name, child));
+        return;
+    }
+    // Insert after any child of the same name, so lookups still find the earliest one
+    vector<Node*>::iterator it = lower_bound(sortedChildren.begin(), sortedChildren.end(), child->name, nameBefore);
+    while (it != sortedChildren.end() && (*it)->name == child->name) ++it;
+    sortedChildren.insert(it, child);
+}
+
+// Remove a child from the index; a later child of the same name takes its place
+void Node::unindexChild(Node* child) {
+    if (!childMap) {
+        vector<Node*>::iterator it = lower_bound(sortedChildren.begin(), sortedChildren.end(), child->name, nameBefore);
+        while (it != sortedChildren.end() && *it != child) ++it;
+        if (it != sortedChildren.end()) sortedChildren.erase(it);
+        return;
+    }
+    unordered_map<string, Node*>::iterator it = childMap->find(child->name);
+    if (it == childMap->end() || it->second != child) return;
+    childMap->erase(it);
+    for (int i = 0; i < children.size(); i++) {
+        if (children[i] != child && children[i]->name == child->name) {
+            childMap->insert(make_pair(child->name, children[i]));
+            break;
+        }
     }
 }
 
 // Get category path for a node
 string Node::getCategory(Node* node) {
-    if (!node) return "";
-    if (!node->parent) return node->name;
-    return node->parent->getCategory(node->parent) + "/" + node->name;
+    if (!node || !node->parent) return "";
+    if (node->path) return *node->path;
+    // Only a node shadowed by a sibling of the same name has no indexed path
+    string parentPath = getCategory(node->parent);
+    return parentPath.empty() ? node->name : parentPath + "/" + node->name;
 }
 
 // Tree constructor
-Tree::Tree(string rootName) {
-    root = new Node(rootName);
+Tree::Tree(string rootName) : nextNodeId(0), bulkDepth(0), countsPending(false) {
+    root = nodePool.create(rootName);
+    root->id = nextNodeId++;
 }
 
-// Tree destructor
+// Tree destructor; the pools destroy all nodes and books slab by slab, before the indexes go
 Tree::~Tree() {
-    delete root;
+    nodePool.clear();
+    bookPool.clear();
+}
+
+// Destroy a subtree that has already been unlinked and unindexed, without recursion
+void Tree::destroySubtree(Node* node) {
+    vector<Node*> pending(1, node);
+    while (!pending.empty()) {
+        node = pending.back();
+        pending.pop_back();
+        for (int i = 0; i < node->books.size(); i++) {
+            columns.remove(node->books[i]);
+            destroyBook(node->books[i]);
+        }
+        for (int i = 0; i < node->children.size(); i++) pending.push_back(node->children[i]);
+        nodePool.destroy(node);
+    }
+}
+
+// The slot of a destroyed book is reused by the next one created, so no borrower may keep pointing at it
+void Tree::destroyBook(Book* book) {
+    for (int i = 0; i < book->currentBorrowers.size(); i++) {
+        SmallVector<Book*, 2>& borrowed = book->currentBorrowers[i]->books_borrowed;
+        for (int j = 0; j < borrowed.size(); j++) {
+            if (borrowed[j] == book) {
+                borrowed.erase(j);
+                break;
+            }
+        }
+    }
+    bookPool.destroy(book);
+}
+
+// Allocate a book next to the previously created ones
+Book* Tree::createBook(string title, string author, string isbn, int publication_year, int total_copies, int available_copies) {
+    return bookPool.create(move(title), move(author), move(isbn), publication_year, total_copies, available_copies);
+}
+
+// Take over books built elsewhere; they are freed with the tree from now on
+void Tree::adoptBooks(ObjectPool<Book>& pool) {
+    bookPool.adopt(pool);
 }
 
 // Get the root of the tree
@@ -52,16 +151,25 @@ Node* Tree::getRoot() {
 
 // Insert a new child into the specified node
 void Tree::insert(Node* node, string name) {
-    Node* child = new Node(name);
+    Node* child = nodePool.create(name);
+    child->id = nextNodeId++;
     child->parent = node;
     node->children.push_back(child);
+    node->indexChild(child);
+    indexPaths(child);
 }
 
 // Remove a specific child by name from a given node
 void Tree::remove(Node* node, string child_name) {
     for (int i = 0; i < node->children.size(); i++) {
         if (node->children[i]->name == child_name) {
-            delete node->children[i];
+            unindexBooks(node->children[i]);
+            // In bulk mode the child's own count may still be missing changes from its subtree
+            if (bulkDepth > 0) updateBookCount(node, propagateCounts(node->children[i]));
+            updateBookCount(node, -(int)node->children[i]->bookCount);
+            node->unindexChild(node->children[i]);
+            unindexPaths(node->children[i]);
+            destroySubtree(node->children[i]);
             node->children.erase(i);
             return;
         }
@@ -75,49 +183,102 @@ bool Tree::isRoot(Node* node) {
 
 // Get a node based on the specified path (e.g., "category/sub-category")
 Node* Tree::getNode(string path) {
-    Node* current = root;
-    size_t pos = 0;
-    while ((pos = path.find('/')) != string::npos) {
-        string category = path.substr(0, pos);
-        current = getChild(current, category);
-        if (!current) return nullptr;
-        path.erase(0, pos + 1);
-    }
-    return getChild(current, path);
+    unordered_map<string, Node*>::iterator it = pathIndex.find(normalizePath(path));
+    return it == pathIndex.end() ? nullptr : it->second;
 }
 
 // Create a node at a specified path
 Node* Tree::createNode(string path) {
+    path = normalizePath(path);
+    unordered_map<string, Node*>::iterator it = pathIndex.find(path);
+    if (it != pathIndex.end()) return it->second;
+
+    // Walk the segments, creating the missing ones
     Node* current = root;
-    size_t pos = 0;
-    while ((pos = path.find('/')) != string::npos) {
-        string category = path.substr(0, pos);
+    size_t start = 0, pos;
+    do {
+        pos = path.find('/', start);
+        string category = path.substr(start, pos == string::npos ? string::npos : pos - start);
         Node* child = getChild(current, category);
         if (!child) {
             insert(current, category);
-            child = getChild(current, category);
+            child = current->children.back();
         }
         current = child;
-        path.erase(0, pos + 1);
+        start = pos + 1;
+    } while (pos != string::npos);
+    return current;
+}
+
+// Drop empty segments so "a/b", "/a/b/" and "a//b" name the same category
+string Tree::normalizePath(const string& path) {
+    if (path.find("//") == string::npos && (path.empty() || (path[0] != '/' && path[path.size() - 1] != '/'))) return path;
+    string normalized;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t pos = path.find('/', start);
+        if (pos == string::npos) pos = path.size();
+        if (pos > start) {
+            if (!normalized.empty()) normalized += '/';
+            normalized.append(path, start, pos - start);
+        }
+        start = pos + 1;
+    }
+    return normalized;
+}
+
+// Register the paths of a subtree; the first node to claim a path keeps it
+void Tree::indexPaths(Node* node) {
+    string parentPath = node->getCategory(node->parent);
+    string path = parentPath.empty() ? node->name : parentPath + "/" + node->name;
+    pair<unordered_map<string, Node*>::iterator, bool> entry = pathIndex.insert(make_pair(path, node));
+    node->path = entry.second ? &entry.first->first : nullptr;   // keys stay put when the map rehashes
+    for (int i = 0; i < node->children.size(); i++) {
+        indexPaths(node->children[i]);
+    }
+}
+
+// Drop the paths of a subtree, e.g. before it is deleted or renamed
+void Tree::unindexPaths(Node* node) {
+    for (int i = 0; i < node->children.size(); i++) {
+        unindexPaths(node->children[i]);
     }
-    Node* child = getChild(current, path);
-    if (!child) {
-        insert(current, path);
-        child = getChild(current, path);
+    if (node->path) {
+        pathIndex.erase(pathIndex.find(*node->path));   // by iterator: the key is the string node->path points to
+        node->path = nullptr;
     }
-    return child;
 }
 
 // Get a child node by name
 Node* Tree::getChild(Node* ptr, string childname) {
-    for (int i = 0; i < ptr->children.size(); i++) {
-        if (ptr->children[i]->name == childname) return ptr->children[i];
+    return ptr->findChild(childname);
+}
+
+// Rename a category; its parent's child index and the paths of its whole subtree change with it.
+// Siblings must keep distinct names and a name must be one path segment: a path can only lead to one node.
+bool Tree::renameNode(Node* node, string newName) {
+    if (newName.empty() || newName.find('/') != string::npos) return false;
+    if (!node->parent) {
+        node->name = newName;
+        return true;
     }
-    return nullptr;
+    if (getChild(node->parent, newName)) return false;
+    node->parent->unindexChild(node);
+    unindexPaths(node);
+    node->name = newName;
+    node->parent->indexChild(node);
+    indexPaths(node);
+    return true;
 }
 
 // Update the book count for a node by the specified offset
 void Tree::updateBookCount(Node* ptr, int offset) {
+    // During a bulk operation only the node itself records the change; commitBulk walks the tree once
+    if (bulkDepth > 0) {
+        ptr->pendingCount += offset;
+        countsPending = true;
+        return;
+    }
     while (ptr) {
         ptr->bookCount += offset;
         ptr = ptr->parent;
@@ -126,46 +287,220 @@ void Tree::updateBookCount(Node* ptr, int offset) {
 
 // Find a book within a specific node
 Book* Tree::findBook(Node* node, string bookTitle) {
-    // Check if the book is in the current node
-    for (int i = 0; i < node->books.size(); i++) {
-        if (node->books[i]->title == bookTitle) return node->books[i];
+    // Look the title up in the index instead of searching the subtree
+    unordered_map<string, BookList>::iterator it = titleIndex.find(bookTitle);
+    if (it == titleIndex.end()) return nullptr;
+
+    // Several categories can hold a book with the same title: take the first one under node
+    BookList& books = it->second;
+    for (int i = 0; i < books.size(); i++) {
+        if (isUnder(books[i]->category, node)) return books[i];
     }
+    return nullptr;
+}
 
-    // Traversing all children nodes recursively
-    MyVector<Node*>& children = node->children; // Use 'node' instead of 'root'
-    for (int i = 0; i < children.size(); ++i) {
-        Book* book = findBook(children.at(i), bookTitle);
-        if (book != nullptr) {
-            return book;  // Return the book found in the child node
+// File a book under a node, index its title and count it in every ancestor
+void Tree::addBook(Node* node, Book* book) {
+    book->category = node;
+    node->books.push_back(book);
+    indexBook(book);
+    columns.add(book, node->id);
+    updateBookCount(node, 1);
+}
+
+// Change a book's title, author and ISBN, moving its index entries along with them
+void Tree::updateBook(Book* book, string title, string author, string isbn) {
+    if (book->title == title && book->author == author && book->isbn == isbn) return;
+    unindexBook(book);
+    book->title = title;
+    book->author = author;
+    book->isbn = isbn;
+    indexBook(book);
+}
+
+// Look up an ISBN however it was typed or scanned
+vector<Book*> Tree::findByISBN(string isbn) {
+    vector<Book*> books;
+    unsigned long long key;
+    if (!isbnKey(isbn, key)) return books;
+    unordered_map<unsigned long long, BookList>::iterator it = isbnIndex.find(key);
+    if (it != isbnIndex.end()) books.assign(it->second.begin(), it->second.end());
+    return books;
+}
+
+// Look up all books of an author
+vector<Book*> Tree::findByAuthor(string author) {
+    vector<Book*> books;
+    unordered_map<string, BookList>::iterator it = authorIndex.find(authorKey(author));
+    if (it != authorIndex.end()) books.assign(it->second.begin(), it->second.end());
+    return books;
+}
+
+// Search the words of the titles rather than whole titles
+vector<Book*> Tree::searchTitle(string words) {
+    return titleSearch.search(words);
+}
+
+// Digits with optional dashes or spaces: 13 digits, or 9 digits and a check digit or X. An ISBN-10
+// becomes the ISBN-13 with the 978 prefix, so both forms of a number find the same books.
+bool Tree::isbnKey(const string& isbn, unsigned long long& key) {
+    string digits;
+    for (size_t i = 0; i < isbn.size(); i++) {
+        char c = isbn[i];
+        if (c >= '0' && c <= '9') digits += c;
+        else if ((c == 'X' || c == 'x') && digits.size() == 9) digits += 'X';
+        else if (c != '-' && c != ' ') return false;
+    }
+    if (digits.size() == 10) {
+        digits = "978" + digits.substr(0, 9);
+        int sum = 0;
+        for (int i = 0; i < 12; i++) sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3);
+        digits += (char)('0' + (10 - sum % 10) % 10);
+    }
+    if (digits.size() != 13 || digits.find('X') != string::npos) return false;
+    key = 0;
+    for (int i = 0; i < 13; i++) key = key * 10 + (digits[i] - '0');
+    return true;
+}
+
+string Tree::authorKey(const string& author) {
+    string key;
+    for (size_t i = 0; i < author.size(); i++) {
+        char c = author[i];
+        if (isspace((unsigned char)c)) {
+            if (!key.empty() && key[key.size() - 1] != ' ') key += ' ';
+        } else {
+            key += (char)tolower((unsigned char)c);
         }
     }
+    if (!key.empty() && key[key.size() - 1] == ' ') key.erase(key.size() - 1);
+    return key;
+}
 
-    // If book is not found in current node or any child nodes
-    return nullptr;
+// Books with an ISBN that is not a valid ISBN-10/13 are only left out of the ISBN index
+void Tree::indexBook(Book* book) {
+    titleIndex[book->title].push_back(book);
+    unsigned long long isbn;
+    if (isbnKey(book->isbn, isbn)) isbnIndex[isbn].push_back(book);
+    authorIndex[authorKey(book->author)].push_back(book);
+    titleSearch.add(book);
 }
 
-// Remove a book from a specific node by title
-bool Tree::removeBook(Node* node, string bookTitle) {
-    // Check if the book is in the current node
-    for (int i = 0; i < node->books.size(); i++) {
-        if (node->books[i]->title == bookTitle) {
-            delete node->books[i];
-            node->books.erase(i);
-            updateBookCount(node, -1);
-            return true;
+// Copy a book's year and copies into its row again
+void Tree::syncBook(Book* book) {
+    columns.update(book);
+}
+
+// Scan the columns; a category other than the root limits the scan to the IDs of its subtree
+int Tree::query(const vector<ColumnRange>& ranges, Node* category, vector<Book*>& matches) {
+    vector<unsigned char> inside;
+    if (category && category != root) {
+        inside.assign(nextNodeId, 0);
+        vector<Node*> pending(1, category);
+        while (!pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            inside[node->id] = 1;
+            for (int i = 0; i < node->children.size(); i++) pending.push_back(node->children[i]);
         }
     }
-    // Traversing all children nodes recursively
-    MyVector<Node*>& children = node->children; // Use 'node' instead of 'root'
-    for (int i = 0; i < children.size(); ++i) {
-        if (removeBook(children[i], bookTitle)) {
-            return true;  // Stop searching once the book is removed
-        }
+    return columns.select(ranges, inside.empty() ? nullptr : &inside, matches);
+}
+
+// Start deferring book count updates; bulk operations may nest
+void Tree::beginBulk() {
+    bulkDepth++;
+}
+
+// Close a bulk operation; the outermost one propagates every deferred count
+void Tree::commitBulk() {
+    if (bulkDepth > 0) bulkDepth--;
+    if (bulkDepth == 0 && countsPending) {
+        propagateCounts(root);
+        countsPending = false;
     }
+}
+
+// Post-order pass: a node's count changes by its own pending count plus those of all its descendants
+int Tree::propagateCounts(Node* node) {
+    int delta = node->pendingCount;
+    node->pendingCount = 0;
+    for (int i = 0; i < node->children.size(); i++) {
+        delta += propagateCounts(node->children[i]);
+    }
+    node->bookCount += delta;
+    return delta;
+}
+
+// Size the title index and the columns up front so a bulk import does not grow them repeatedly
+void Tree::reserveBooks(size_t count) {
+    titleIndex.reserve(titleIndex.size() + count);
+    isbnIndex.reserve(isbnIndex.size() + count);
+    columns.reserve(count);
+}
 
+// Check whether a node lies in the subtree of ancestor
+bool Tree::isUnder(Node* node, Node* ancestor) {
+    if (ancestor == root) return true;
+    for (; node != nullptr; node = node->parent) {
+        if (node == ancestor) return true;
+    }
     return false;
 }
 
+// Remove a book from the postings of key, dropping the key with its last book
+template <typename Index, typename Key>
+static void erasePosting(Index& index, const Key& key, Book* book) {
+    typename Index::iterator it = index.find(key);
+    if (it == index.end()) return;
+    BookList& books = it->second;
+    for (int i = 0; i < books.size(); i++) {
+        if (books[i] == book) {
+            books.erase(i);
+            break;
+        }
+    }
+    if (books.empty()) index.erase(it);
+}
+
+// Remove a single book from the indexes
+void Tree::unindexBook(Book* book) {
+    erasePosting(titleIndex, book->title, book);
+    unsigned long long isbn;
+    if (isbnKey(book->isbn, isbn)) erasePosting(isbnIndex, isbn, book);
+    erasePosting(authorIndex, authorKey(book->author), book);
+    titleSearch.remove(book);
+}
+
+// Remove every book of a subtree from the indexes before the subtree is deleted
+void Tree::unindexBooks(Node* node) {
+    for (int i = 0; i < node->books.size(); i++) {
+        unindexBook(node->books[i]);
+    }
+    for (int i = 0; i < node->children.size(); i++) {
+        unindexBooks(node->children[i]);
+    }
+}
+
+// Remove a book from a specific node by title
+bool Tree::removeBook(Node* node, string bookTitle) {
+    Book* book = findBook(node, bookTitle);
+    if (book == nullptr) return false;
+
+    Node* category = book->category;
+    for (int i = 0; i < category->books.size(); i++) {
+        if (category->books[i] == book) {
+            category->books.erase(i);
+            break;
+        }
+    }
+    unindexBook(book);
+    columns.remove(book);
+    updateBookCount(category, -1);
+    destroyBook(book);
+    return true;
+}
+
 // Print all books in the node and its children
 void Tree::printAll(Node* node) {
     if (node == nullptr) return;
@@ -207,19 +542,98 @@ void Tree::print_helper(string padding, string pointer, Node* node) {
 
 // Export all books of a given node to a specified file
 int Tree::exportData(Node* node, ofstream& file) {
-    int count = 0;
-    for (int i = 0; i < node->books.size(); i++) {
+    string out;
+    serializeSubtree(node, out);
+    file.write(out.data(), out.size());
+    return node->bookCount;
+}
 
-        file << node->books[i]->title << ",";
-        file << node->books[i]->author << ",";
-        file << node->books[i]->isbn << ",";
-        file << node->books[i]->publication_year << ",";
-        file << node->books[i]->total_copies << ",";
-        file << node->books[i]->available_copies << "\n";
-        count++;
+// Append one CSV row per book: Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies
+void Tree::serializeBooks(Node* node, int first, int last, string& out) {
+    string category = node->getCategory(node);
+    char number[16];
+    for (int i = first; i < last; i++) {
+        Book* book = node->books[i];
+        appendCsvField(out, book->title);
+        out += ',';
+        appendCsvField(out, book->author);
+        out += ',';
+        appendCsvField(out, book->isbn);
+        out.append(number, snprintf(number, sizeof(number), ",%d,", book->publication_year));
+        appendCsvField(out, category);
+        out.append(number, snprintf(number, sizeof(number), ",%d,", book->total_copies));
+        out.append(number, snprintf(number, sizeof(number), "%d\n", book->available_copies));
     }
+}
+
+// Append the rows of a whole subtree: a node's own books, then each child in order
+void Tree::serializeSubtree(Node* node, string& out) {
+    serializeBooks(node, 0, node->books.size(), out);
     for (int i = 0; i < node->children.size(); i++) {
-        count += exportData(node->children[i], file);
+        serializeSubtree(node->children[i], out);
+    }
+}
+
+// Small subtrees become one task; larger ones are split into their own books and their children
+void Tree::planExport(Node* node, int limit, vector<ExportTask>& tasks) {
+    if ((int)node->bookCount <= limit) {
+        if (node->bookCount > 0) {
+            ExportTask task = {node, 0, node->books.size(), true};
+            tasks.push_back(task);
+        }
+        return;
+    }
+    for (int i = 0; i < node->books.size(); i += limit) {
+        ExportTask task = {node, i, min(i + limit, node->books.size()), false};
+        tasks.push_back(task);
+    }
+    for (int i = 0; i < node->children.size(); i++) {
+        planExport(node->children[i], limit, tasks);
+    }
+}
+
+// Export the whole catalog. A batch of tasks is serialized into per-task buffers by all threads
+// while a writer thread appends the previous batch to the file, so the output stays in tree order.
+int Tree::exportAll(string path) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return -1;
+    const string header = "Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies\n";
+    bool written = fwrite(header.data(), 1, header.size(), file) == header.size();
+
+    unsigned int threads = max(1u, thread::hardware_concurrency());
+    int limit = max(1024, min(65536, (int)(root->bookCount / (threads * 8))));
+    vector<ExportTask> tasks;
+    planExport(root, limit, tasks);
+
+    size_t batch = threads * 2;
+    vector<string> filling(batch), writing(batch);
+    thread writer;
+    for (size_t start = 0; start < tasks.size(); start += batch) {
+        size_t count = min(batch, tasks.size() - start);
+        atomic<size_t> next(0);
+        auto serialize = [&]() {
+            for (size_t i; (i = next++) < count; ) {
+                const ExportTask& task = tasks[start + i];
+                filling[i].clear();
+                if (task.subtree) serializeSubtree(task.node, filling[i]);
+                else serializeBooks(task.node, task.first, task.last, filling[i]);
+            }
+        };
+        vector<thread> workers;
+        for (unsigned int t = 1; t < threads; t++) workers.push_back(thread(serialize));
+        serialize();
+        for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+
+        // Hand the batch to the writer once it has finished the previous one
+        if (writer.joinable()) writer.join();
+        filling.swap(writing);
+        writer = thread([&writing, &written, count, file]() {
+            for (size_t i = 0; i < count; i++) {
+                if (fwrite(writing[i].data(), 1, writing[i].size(), file) != writing[i].size()) written = false;
+            }
+        });
     }
-    return count;
+    if (writer.joinable()) writer.join();
+    written = (fclose(file) == 0) && written;
+    return written ? (int)root->bookCount : -1;
 }
@@ -9,17 +9,32 @@
 #ifndef _TREE_H
 #define _TREE_H
 #include<string>
+#include<unordered_map>
+#include<vector>
 #include "myvector.h"
 #include "book.h"
+#include "pool.h"
+#include "bookcolumns.h"
+#include "titlesearch.h"
 using namespace std;
 class Node
 {
 	private:
 		string name;				//name of the Node
-		MyVector<Node*> children;	//Children of Node
-		MyVector<Book*> books;		//Books in every Node
+		SmallVector<Node*, 4> children;	//Children of Node, the first 4 stored inline
+		SmallVector<Book*, 4> books;		//Books in every Node, the first 4 stored inline
 		unsigned int bookCount;
+		int pendingCount;			//change to bookCount of this subtree not yet applied to the ancestors (bulk mode)
 		Node* parent; 				//link to the parent 
+		int id;						//category ID in the tree's book columns
+		const string* path;			//full path, interned as this node's key in the tree's path index (nullptr for the root)
+		vector<Node*> sortedChildren;			//children ordered by name, used while there are few of them
+		unordered_map<string, Node*>* childMap;	//name -> first child of that name, replaces sortedChildren once it is built
+		static const int CHILD_MAP_THRESHOLD = 32;	//number of children at which the hash map takes over
+		static bool nameBefore(Node* child, const string& name);	//sortedChildren order
+		Node* findChild(const string& childname);	//lookup through the index, children keeps the display order
+		void indexChild(Node* child);				//add a child that was just appended to children
+		void unindexChild(Node* child);				//remove a child that is still in children
 
 	public:
 		//constructor to create an empty node (category/sub-category)
@@ -28,9 +43,10 @@ class Node
 		// return category of a node (e.g. "Computer Science/Operating Systems")
 		// where "Operator System" is the name of current node and "Operating System"
 		// is the name of the parent node which is a child of the root node.
+		// The path is cached on the node, so this does not walk up the tree.
 		string getCategory(Node* node);
 		
-		//deletes a node and clear/clean all its vectors
+		//clear/clean all its vectors; children and books belong to the tree's pools
 		~Node();	
 
 	public:
@@ -38,10 +54,45 @@ class Node
 		friend class LCMS;
 };
 //==========================================================
+// One unit of export work: books [first, last) of node, and with subtree set, everything below it too
+struct ExportTask
+{
+	Node* node;
+	int first;
+	int last;
+	bool subtree;
+};
+//==========================================================
+typedef SmallVector<Book*, 1> BookList;	//books sharing an index key, in the order they were added (usually one, kept inline)
+//==========================================================
 class Tree
 {
 	private:
+		ObjectPool<Node> nodePool;	//every node of the tree, released in bulk with the tree
+		ObjectPool<Book> bookPool;	//every book filed in the tree
 		Node *root;				//root of the Tree
+		BookColumns columns;	//year and copies of every book, for query scans
+		int nextNodeId;			//ID for the next category created
+		void destroySubtree(Node* node);				//return a subtree's nodes and books to the pools
+		void destroyBook(Book* book);					//take a book off its borrowers' lists and return it to the pool
+		unordered_map<string, BookList> titleIndex;		//title -> books with that title
+		unordered_map<unsigned long long, BookList> isbnIndex;	//ISBN-13 as a number -> books with that ISBN
+		unordered_map<string, BookList> authorIndex;	//normalized author -> books by that author
+		TitleSearch titleSearch;						//title words -> books
+		static bool isbnKey(const string& isbn, unsigned long long& key);	//ISBN-10 or -13, with or without dashes, as an ISBN-13 number
+		static string authorKey(const string& author);	//lower case, single spaces, trimmed
+		void indexBook(Book* book);						//add a book to the title, ISBN, author and title word indexes
+		void unindexBook(Book* book);					//drop a book from the title, ISBN, author and title word indexes
+		void unindexBooks(Node* node);					//drop every book of a subtree from the indexes
+		int bulkDepth;									//> 0 while a bulk operation is open
+		bool countsPending;								//some node has a pendingCount to propagate
+		int propagateCounts(Node* node);				//post-order: apply pending counts, return the subtree's total change
+		unordered_map<string, Node*> pathIndex;			//"category/sub-category" -> node, owns the strings Node::path points to
+		void indexPaths(Node* node);					//register the paths of a subtree whose parent is already registered
+		void unindexPaths(Node* node);					//drop the paths of a subtree
+		void planExport(Node* node, int limit, vector<ExportTask>& tasks);	//cut a subtree into tasks of about limit books, in tree order
+		void serializeBooks(Node* node, int first, int last, string& out);	//append CSV rows for some books of a node
+		void serializeSubtree(Node* node, string& out);						//append CSV rows for a whole subtree, pre-order
 		
 	public:	 	//Required methods
 		Tree(string rootName);	
@@ -52,15 +103,31 @@ class Tree
 		bool isRoot(Node* node); 						//return true if the given node is the root, false otherwise
 		Node* getNode(string path);						//given a path (category/sub-category/sub-category/..) the method should return the Node if found, false otherwise
 		Node* createNode(string path);					//Create a node on a given path, e.g. category/sub-category/sub-category/...
+		static string normalizePath(const string& path);	//drop empty segments, e.g. "/a//b/" -> "a/b"
 		Node* getChild(Node *ptr, string childname);	//given a node and name of a child, the method returns pointer to the child node if exist, nullptr otherwise
 		void updateBookCount(Node *ptr, int offset);	//update a books count by an offset e.g. +1/-1
+		void beginBulk();								//defer book count updates until the matching commitBulk
+		void commitBulk();								//propagate all deferred book counts in one pass
+		bool renameNode(Node* node, string newName);	//rename a category, keeping its parent's child index in sync; false if the name is empty, has a '/' or a sibling has it
 		Book* findBook(Node *node, string bookTitle);	//find a book in a given node, returns nullptr the book is not found
+		Book* createBook(string title, string author, string isbn, int publication_year, int total_copies, int available_copies);	//allocate a book in the tree's pool, to be filed with addBook
+		void adoptBooks(ObjectPool<Book>& pool);		//take ownership of books created in another pool, e.g. by import threads
+		void addBook(Node* node, Book* book);			//file a book under a node, index it and update the book counts
+		void updateBook(Book* book, string title, string author, string isbn);	//change the indexed fields of a book and its index entries
+		vector<Book*> findByISBN(string isbn);			//books with an ISBN, given as ISBN-10 or ISBN-13
+		vector<Book*> findByAuthor(string author);		//books by an author, ignoring case and extra spaces
+		vector<Book*> searchTitle(string words);		//books with all the words in their title, best matches first
+		void syncBook(Book* book);						//refresh the columns after a book's year or copies changed
+		int query(const vector<ColumnRange>& ranges, Node* category, vector<Book*>& matches);	//books under category matching every range; returns the rows scanned
+		void reserveBooks(size_t count);				//make room in the title index and the columns for count more books
+		bool isUnder(Node* node, Node* ancestor);		//true if node is ancestor or one of its descendants
 		bool removeBook(Node* node,string bookTitle);   //remove a book from a given node
 		void printAll(Node *node);					    //printAll books of a node and it children recursively (see output of findAll command)
 		bool isLastChild(Node *ptr);	//given a pointer to node, the method should determine that the node is the last child in the children vector or not
 		void print();			//Print all categories/sub-categories of a the tree. see output of list command (please use the implementation given below)
 		void print_helper(string padding, string pointer,Node *node); // helper method for the print() (please use the implementation given below)
 		int exportData(Node *node,ofstream& file);		//Export all books of a given node to a specific file.
+		int exportAll(string path);						//Export the catalog as CSV, serializing subtrees in parallel; -1 if the file can't be written
 		//bool isEmpty();									//return true if the tree is empty false otherwise
 };
 /*
@@ -0,0 +1,103 @@
+//============================================================================
+// Name         : vectorbench.cpp
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Benchmarks comparing MyVector with std::vector
+//============================================================================
+
+#include "vectorbench.h"
+#include "myvector.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static volatile long long sink;     // keeps results alive so the loops are not optimized away
+
+// Milliseconds taken by one call of work
+template <typename Work>
+static double timeIt(Work work) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    work();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename Vector>
+static double pushInts(int n, bool reserve) {
+    return timeIt([&]() {
+        Vector v;
+        if (reserve) v.reserve(n);
+        for (int i = 0; i < n; i++) v.push_back(i);
+        sink = v[n - 1];
+    });
+}
+
+// Strings long enough to live on the heap: growth either moves them or copies them
+template <typename Vector>
+static double pushStrings(int n) {
+    return timeIt([&]() {
+        Vector v;
+        for (int i = 0; i < n; i++) v.emplace_back(32, (char)('a' + i % 26));
+        sink = v[n - 1].size();
+    });
+}
+
+template <typename Vector>
+static double sumByIndex(Vector& v, int rounds) {
+    return timeIt([&]() {
+        long long sum = 0;
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < (int)v.size(); i++) sum += v[i];
+        }
+        sink = sum;
+    });
+}
+
+template <typename Vector>
+static double sortValues(const vector<int>& values) {
+    Vector v;
+    v.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) v.push_back(values[i]);
+    return timeIt([&]() {
+        sort(v.begin(), v.end());
+        sink = v[0];
+    });
+}
+
+static void printRow(string operation, double mine, double standard) {
+    cout << left << setw(34) << operation << right << fixed << setprecision(1)
+         << setw(12) << mine << setw(14) << standard << endl;
+}
+
+void benchmarkVectors(string count) {
+    int n = count.empty() ? 10000000 : stoi(count);
+    if (n <= 0) throw invalid_argument("benchVector: the element count must be positive");
+    int strings = max(1, n / 10);
+
+    cout << left << setw(34) << "Operation (ms)" << right << setw(12) << "MyVector" << setw(14) << "std::vector" << endl;
+    printRow("push_back " + to_string(n) + " ints", pushInts<MyVector<int> >(n, false), pushInts<vector<int> >(n, false));
+    printRow("  after reserve", pushInts<MyVector<int> >(n, true), pushInts<vector<int> >(n, true));
+    printRow("emplace_back " + to_string(strings) + " strings", pushStrings<MyVector<string> >(strings), pushStrings<vector<string> >(strings));
+
+    MyVector<int, true> checked;
+    MyVector<int, false> unchecked;
+    vector<int> standard;
+    for (int i = 0; i < n; i++) {
+        checked.push_back(i);
+        unchecked.push_back(i);
+        standard.push_back(i);
+    }
+    double standardSum = sumByIndex(standard, 10);
+    printRow("10 x sum via operator[], checked", sumByIndex(checked, 10), standardSum);
+    printRow("  unchecked", sumByIndex(unchecked, 10), standardSum);
+
+    vector<int> values(n);
+    mt19937 random(7);
+    for (int i = 0; i < n; i++) values[i] = random();
+    printRow("std::sort through iterators", sortValues<MyVector<int> >(values), sortValues<vector<int> >(values));
+}
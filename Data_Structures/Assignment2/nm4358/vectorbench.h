@@ -0,0 +1,17 @@
+//============================================================================
+// Name         : vectorbench.h
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19 Oct
+// Date Modified: 19 Oct
+// Description  : Benchmarks comparing MyVector with std::vector
+//============================================================================
+#ifndef _VECTORBENCH_H
+#define _VECTORBENCH_H
+#include<string>
+using namespace std;
+
+// Time growth, reserve, move-aware growth, element access (checked and unchecked)
+// and std::sort through iterators for MyVector and std::vector. count defaults to 10M.
+void benchmarkVectors(string count);
+#endif
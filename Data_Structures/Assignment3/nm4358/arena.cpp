@@ -0,0 +1,80 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Monotonic arena that keeps its pages across resets
+//============================================================================
+#include "arena.h"
+#include <algorithm>
+#include <new>
+using namespace std;
+
+Arena::Arena() : page(0), used(0) {}
+
+Arena::~Arena()
+{
+	for (char* p : pages) ::operator delete(p);
+	releaseLarge();
+}
+
+void Arena::releaseLarge()
+{
+	for (Block& b : large) ::operator delete(b.p, align_val_t(b.alignment));
+	large.clear();
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment)
+{
+	if (bytes > PAGE_SIZE / 4 || alignment > alignof(max_align_t))
+	{
+		alignment = max(alignment, alignof(max_align_t));
+		void* block = ::operator new(bytes, align_val_t(alignment));
+		large.push_back(Block{ block, bytes, alignment });
+		return block;
+	}
+	while (true)
+	{
+		if (page < pages.size())
+		{
+			size_t start = (used + alignment - 1) & ~(alignment - 1);
+			if (start + bytes <= PAGE_SIZE)
+			{
+				used = start + bytes;
+				return pages[page] + start;
+			}
+			page++;
+			used = 0;
+			continue;
+		}
+		pages.push_back((char*)::operator new(PAGE_SIZE));
+	}
+}
+
+void Arena::do_deallocate(void*, size_t, size_t)
+{
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+void Arena::reset()
+{
+	page = 0;
+	used = 0;
+	releaseLarge();
+}
+
+size_t Arena::reserved() const
+{
+	size_t bytes = pages.size() * PAGE_SIZE;
+	for (const Block& b : large) bytes += b.bytes;
+	return bytes;
+}
+
+size_t Arena::inUse() const
+{
+	return page * PAGE_SIZE + used;
+}
@@ -0,0 +1,43 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Monotonic arena that keeps its pages across resets
+//============================================================================
+
+#ifndef _ARENA_H
+#define _ARENA_H
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+using std::vector;
+
+// Bump allocator for the table's keys, nodes and heap storage. Nothing is freed
+// one by one: reset() rewinds to the first page in O(1) and the same pages are
+// handed out again, so the next import never goes back to malloc for them.
+// Blocks larger than a quarter page get their own allocation, released on reset.
+class Arena : public std::pmr::memory_resource
+{
+	private:
+		static constexpr size_t PAGE_SIZE = 1 << 20;
+		vector<char*> pages;			// every page ever allocated, reused in order
+		size_t page;					// index of the page being filled
+		size_t used;					// bytes used in that page
+		struct Block { void* p; size_t bytes; size_t alignment; };
+		vector<Block> large;			// oversized blocks
+		void releaseLarge();
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;	// no-op, see reset()
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	public:
+		Arena();
+		~Arena();
+		void reset();
+		size_t reserved() const;		// bytes held, in pages and oversized blocks
+		size_t inUse() const;			// bytes handed out since the last reset (pages only)
+};
+#endif
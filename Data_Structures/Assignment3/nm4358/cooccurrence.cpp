@@ -0,0 +1,140 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word pair counts within a sliding context of k tokens
+//============================================================================
+#include "cooccurrence.h"
+using namespace std;
+
+CooccurrenceCounter::CooccurrenceCounter(unsigned int context)
+	: context(context), recent(context), position(0), keys(1 << 16, EMPTY), counts(1 << 16, 0), shift(64 - 16), pairs(0), updates(0) {}
+
+uint32_t CooccurrenceCounter::intern(const string& word)
+{
+	auto it = ids.find(word);
+	if (it != ids.end()) return it->second;
+	uint32_t id = words.size();
+	words.push_back(word);
+	ids.emplace(words.back(), id);
+	return id;
+}
+
+// Fibonacci hashing: the top bits of key * 2^64/phi pick the slot
+size_t CooccurrenceCounter::slotOf(uint64_t key) const
+{
+	return (key * 0x9E3779B97F4A7C15ULL) >> shift;
+}
+
+void CooccurrenceCounter::bump(uint64_t key)
+{
+	size_t mask = keys.size() - 1;
+	size_t slot = slotOf(key);
+	while (keys[slot] != key)
+	{
+		if (keys[slot] == EMPTY)
+		{
+			// Keep the load under 70% so probe runs stay short
+			if ((pairs + 1) * 10 > keys.size() * 7)
+			{
+				grow();
+				bump(key);
+				return;
+			}
+			keys[slot] = key;
+			pairs++;
+			break;
+		}
+		slot = (slot + 1) & mask;
+	}
+	counts[slot]++;
+}
+
+void CooccurrenceCounter::grow()
+{
+	vector<uint64_t> old_keys(keys.size() * 2, EMPTY);
+	vector<uint32_t> old_counts(counts.size() * 2, 0);
+	old_keys.swap(keys);
+	old_counts.swap(counts);
+	shift--;
+	size_t mask = keys.size() - 1;
+	for (size_t i = 0; i < old_keys.size(); i++)
+	{
+		if (old_keys[i] == EMPTY) continue;
+		size_t slot = slotOf(old_keys[i]);
+		while (keys[slot] != EMPTY) slot = (slot + 1) & mask;
+		keys[slot] = old_keys[i];
+		counts[slot] = old_counts[i];
+	}
+}
+
+void CooccurrenceCounter::add(const string& word)
+{
+	uint32_t id = intern(word);
+	unsigned long before = min<unsigned long>(position, context);
+	for (unsigned long d = 1; d <= before; d++)
+	{
+		uint32_t other = recent[(position - d) % context];
+		if (other == id) continue;
+		uint64_t key = other < id ? (uint64_t)other << 32 | id : (uint64_t)id << 32 | other;
+		bump(key);
+		updates++;
+	}
+	recent[position % context] = id;
+	position++;
+}
+
+void CooccurrenceCounter::endDocument()
+{
+	position = 0;
+}
+
+vector<WordCount> CooccurrenceCounter::partners(const string& word, unsigned int k)
+{
+	TopK best(k);
+	auto it = ids.find(word);
+	if (it == ids.end()) return best.result();
+	uint32_t id = it->second;
+	// Pairs are stored once, so the word's row is every key with id on either side
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		uint64_t key = keys[i];
+		if (key == EMPTY) continue;
+		uint32_t a = key >> 32, b = (uint32_t)key;
+		if (a == id) best.offer(words[b], counts[i]);
+		else if (b == id) best.offer(words[a], counts[i]);
+	}
+	return best.result();
+}
+
+unsigned int CooccurrenceCounter::getContext() const
+{
+	return context;
+}
+
+uint64_t CooccurrenceCounter::getUpdates() const
+{
+	return updates;
+}
+
+size_t CooccurrenceCounter::getPairs() const
+{
+	return pairs;
+}
+
+size_t CooccurrenceCounter::memoryUsed() const
+{
+	return keys.size() * sizeof(uint64_t) + counts.size() * sizeof(uint32_t);
+}
+
+void CooccurrenceCounter::clear()
+{
+	ids.clear();
+	words.clear();
+	position = 0;
+	fill(keys.begin(), keys.end(), EMPTY);
+	fill(counts.begin(), counts.end(), 0);
+	pairs = 0;
+	updates = 0;
+}
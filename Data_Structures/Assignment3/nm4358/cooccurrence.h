@@ -0,0 +1,57 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word pair counts within a sliding context of k tokens
+//============================================================================
+
+#ifndef _COOCCURRENCE_H
+#define _COOCCURRENCE_H
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "topk.h"
+using std::string;
+using std::vector;
+
+// Every word is interned to a 32-bit id on first sight, and each new token is paired
+// with the up to k tokens before it in the same document. A pair of ids is packed into
+// one 64-bit key (smaller id first, so pairs are unordered) and counted in a flat
+// open-addressing table: keys and counts live in two arrays that only grow by doubling,
+// so a pair update never allocates. Pairs of a word with itself are not counted.
+class CooccurrenceCounter
+{
+	private:
+		static constexpr uint64_t EMPTY = ~0ULL;	// no id pair packs to this
+		unsigned int context;						// tokens before each token that count as its context
+		std::deque<string> words;					// id -> word; a deque never moves its strings
+		std::unordered_map<std::string_view, uint32_t> ids;	// word -> id, viewing words
+		vector<uint32_t> recent;					// ring of the last context ids of this document
+		unsigned long position;						// tokens seen in this document
+		vector<uint64_t> keys;						// packed pairs, EMPTY for free slots
+		vector<uint32_t> counts;
+		unsigned int shift;							// 64 - log2(table size)
+		size_t pairs;								// occupied slots
+		uint64_t updates;							// pair increments so far
+
+		uint32_t intern(const string& word);
+		size_t slotOf(uint64_t key) const;
+		void bump(uint64_t key);
+		void grow();
+
+	public:
+		CooccurrenceCounter(unsigned int context);
+		void add(const string& word);				// next token of the current document
+		void endDocument();							// no pairs across this point
+		vector<WordCount> partners(const string& word, unsigned int k);	// k words most often near word
+		unsigned int getContext() const;
+		uint64_t getUpdates() const;
+		size_t getPairs() const;
+		size_t memoryUsed() const;					// bytes in the pair table
+		void clear();
+};
+#endif
@@ -0,0 +1,173 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Read-only front-coded dictionary of words and frequencies
+//============================================================================
+#include "frontcoded.h"
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+// Lengths are stored as base-128 varints: one byte for anything under 128
+static void putVarint(vector<char>& out, size_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((char)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((char)value);
+}
+
+static size_t getVarint(const char*& p)
+{
+	size_t value = 0;
+	for (int shift = 0;; shift += 7)
+	{
+		unsigned char byte = *p++;
+		value |= (size_t)(byte & 0x7F) << shift;
+		if (byte < 0x80) return value;
+	}
+}
+
+FrontCodedDictionary::FrontCodedDictionary(const vector<WordEntry>& sorted) : words(sorted.size()), total(0)
+{
+	unsigned int max_freq = 0;
+	string_view previous;
+	uint64_t bit = 0;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		string_view word = sorted[i].word;
+		if (i % BLOCK == 0)
+		{
+			blocks.push_back(data.size());
+			putVarint(data, word.size());
+			data.insert(data.end(), word.begin(), word.end());
+
+			// This block's frequencies at the width of its largest
+			size_t end = min(sorted.size(), i + BLOCK);
+			unsigned int largest = 0;
+			for (size_t j = i; j < end; j++) largest = max(largest, sorted[j].freq);
+			uint8_t width = 0;
+			while (width < 32 && (largest >> width) != 0) width++;
+			widths.push_back(width);
+			freq_offsets.push_back(bit);
+			bits.resize((bit + (end - i) * width + 63) / 64 + 1, 0);
+			for (size_t j = i; j < end; j++, bit += width)
+			{
+				uint64_t f = sorted[j].freq;
+				bits[bit / 64] |= f << (bit % 64);
+				if (bit % 64 + width > 64) bits[bit / 64 + 1] |= f >> (64 - bit % 64);
+			}
+		}
+		else
+		{
+			size_t shared = 0;
+			while (shared < word.size() && shared < previous.size() && word[shared] == previous[shared]) shared++;
+			putVarint(data, shared);
+			putVarint(data, word.size() - shared);
+			data.insert(data.end(), word.begin() + shared, word.end());
+		}
+		previous = word;
+		total += sorted[i].freq;
+		if (sorted[i].freq > max_freq)
+		{
+			max_freq = sorted[i].freq;
+			max_word = string(word);
+		}
+	}
+	data.shrink_to_fit();
+	blocks.shrink_to_fit();
+	bits.shrink_to_fit();
+	freq_offsets.shrink_to_fit();
+	widths.shrink_to_fit();
+}
+
+string_view FrontCodedDictionary::head(size_t block) const
+{
+	const char* p = data.data() + blocks[block];
+	size_t length = getVarint(p);
+	return string_view(p, length);
+}
+
+unsigned int FrontCodedDictionary::freqAt(size_t index) const
+{
+	size_t block = index / BLOCK;
+	unsigned int width = widths[block];
+	if (width == 0) return 0;
+	uint64_t bit = freq_offsets[block] + (index % BLOCK) * width;
+	uint64_t value = bits[bit / 64] >> (bit % 64);
+	if (bit % 64 + width > 64) value |= bits[bit / 64 + 1] << (64 - bit % 64);
+	return value & ((1ULL << width) - 1);
+}
+
+unsigned int FrontCodedDictionary::find_freq(string_view word) const
+{
+	// Last block whose head is <= word
+	size_t low = 0, high = blocks.size();
+	while (low < high)
+	{
+		size_t mid = (low + high) / 2;
+		if (head(mid) <= word) low = mid + 1;
+		else high = mid;
+	}
+	if (low == 0) return 0;
+	size_t block = low - 1;
+
+	const char* p = data.data() + blocks[block];
+	size_t length = getVarint(p);
+	string current(p, length);
+	p += length;
+	size_t index = block * BLOCK;
+	size_t end = min(words, index + BLOCK);
+	while (true)
+	{
+		if (current == word) return freqAt(index);
+		if (current > word || ++index == end) return 0;
+		size_t shared = getVarint(p);
+		size_t rest = getVarint(p);
+		current.resize(shared);
+		current.append(p, rest);
+		p += rest;
+	}
+}
+
+string FrontCodedDictionary::findMax() const
+{
+	if (words == 0) throw out_of_range("Heap is empty.");
+	return max_word;
+}
+
+size_t FrontCodedDictionary::getUniqueWords() const
+{
+	return words;
+}
+
+uint64_t FrontCodedDictionary::getTotalWords() const
+{
+	return total;
+}
+
+void FrontCodedDictionary::forEach(const function<void(string_view, unsigned int)>& visit) const
+{
+	const char* p = data.data();
+	string current;
+	for (size_t i = 0; i < words; i++)
+	{
+		size_t shared = 0;
+		if (i % BLOCK != 0) shared = getVarint(p);
+		size_t rest = getVarint(p);
+		current.resize(shared);
+		current.append(p, rest);
+		p += rest;
+		visit(current, freqAt(i));
+	}
+}
+
+size_t FrontCodedDictionary::memoryUsed() const
+{
+	return data.capacity() + blocks.capacity() * sizeof(uint32_t) + bits.capacity() * sizeof(uint64_t)
+		   + freq_offsets.capacity() * sizeof(uint64_t) + widths.capacity() + max_word.capacity() + sizeof(*this);
+}
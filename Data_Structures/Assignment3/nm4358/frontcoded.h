@@ -0,0 +1,51 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Read-only front-coded dictionary of words and frequencies
+//============================================================================
+
+#ifndef _FRONTCODED_H
+#define _FRONTCODED_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sorting.h"
+using std::string;
+using std::vector;
+
+// Words are kept in alphabetical order in blocks of BLOCK words. The first word of a
+// block is stored whole; every other word as the length of the prefix it shares with
+// the word before it, the length of the rest, and the rest. A lookup binary-searches
+// the block heads and decodes one block.
+// Frequencies use frame-of-reference packing: the BLOCK frequencies of a block are
+// stored at the bit width of the largest one, so the many rare words take a few bits.
+class FrontCodedDictionary
+{
+	private:
+		static constexpr unsigned int BLOCK = 16;
+		vector<char> data;						// front-coded blocks, back to back
+		vector<uint32_t> blocks;				// byte offset of each block in data
+		vector<uint64_t> bits;					// packed frequencies
+		vector<uint64_t> freq_offsets;			// bit offset of each block's frequencies
+		vector<uint8_t> widths;					// bits per frequency in each block
+		size_t words;
+		uint64_t total;
+		string max_word;
+
+		std::string_view head(size_t block) const;
+		unsigned int freqAt(size_t index) const;
+
+	public:
+		FrontCodedDictionary(const vector<WordEntry>& sorted);	// entries in alphabetical order
+		unsigned int find_freq(std::string_view word) const;	// 0 if absent
+		string findMax() const;					// most frequent word, alphabetically first on ties
+		size_t getUniqueWords() const;
+		uint64_t getTotalWords() const;
+		void forEach(const std::function<void(std::string_view, unsigned int)>& visit) const;	// alphabetical order
+		size_t memoryUsed() const;
+};
+#endif
@@ -10,10 +10,36 @@
 #include "hashtable.h"
 #include "linkedlist.h"
 #include "maxheap.h"
+#include "tokenizer.h"
+#include "threadpool.h"
+#include "pipeline.h"
+#include "inputstream.h"
+#include "windowcounter.h"
+#include "sorting.h"
+#include "arena.h"
+#include "spillstore.h"
+#include "manifest.h"
+#include "siphash.h"
+#include "cooccurrence.h"
+#include "frontcoded.h"
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <glob.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 using namespace std;
 using std::ifstream;
 using std::string;
@@ -28,6 +54,34 @@ HashTable::HashTable(int capacity)
     this->unique_words = 0;
     this->total_words = 0;
     this->hash_code_function = 1; // Default hash function
+    this->window = nullptr;
+    this->arena = nullptr;
+    this->spill = nullptr;
+    this->memory_used = capacity * sizeof(LinkedList);
+    this->manifest = new Manifest;
+    this->cooccur = nullptr;
+    this->speller = nullptr;
+    this->dictionary = nullptr;
+}
+
+// Bytes one more unique word costs the table: its node and allocator header, its heap slot
+// (the vector may be twice as long as needed), its entry and merge scratch when a run is
+// sorted, and the key's own allocation once it is too long for the inline buffer
+static size_t wordFootprint(const string& word)
+{
+    return sizeof(Node) + 16 + sizeof(LinkedList*) * 2 + sizeof(WordEntry) * 2 + (word.size() > 15 ? word.size() + 17 : 0);
+}
+
+// One random SipHash key per process, so bucket positions cannot be predicted from outside
+static const uint64_t* processKey()
+{
+    static const uint64_t* key = [] {
+        static uint64_t k[2];
+        random_device device;
+        for (uint64_t& part : k) part = ((uint64_t)device() << 32) ^ device();
+        return k;
+    }();
+    return key;
 }
 
 unsigned long HashTable::hashCode(string key) {
@@ -64,6 +118,9 @@ unsigned long HashTable::hashCode(string key) {
         for (int i = 0; i < key.length(); i++) {
             hash = (hash << 4) ^ (hash >> 28) ^ key[i];
         }
+    } else if (hash_code_function == 7) {
+        // Function 7: SipHash-1-3 keyed with a per-process random key
+        hash = siphash13(key.data(), key.length(), processKey()[0], processKey()[1]);
     } else {
         throw std::invalid_argument("Unsupported hash_code function");
     }
@@ -71,6 +128,139 @@ unsigned long HashTable::hashCode(string key) {
     return hash % capacity; // Ensure hash fits within the table size
 }
 
+void HashTable::setHashFunction(int function){
+    if (function < 1 || function > 7) throw std::invalid_argument("Usage: hash <1-7> (7 is keyed SipHash)");
+    auto start = chrono::steady_clock::now();
+    // Relink every node into its bucket under the new function; nodes and keys stay where they are
+    vector<Node*> nodes;
+    nodes.reserve(unique_words);
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) nodes.push_back(node);
+        buckets[i].head = nullptr;
+        buckets[i].size = 0;
+    }
+    hash_code_function = function;
+    collisions = 0;
+    vector<Node*> tails(capacity, nullptr);
+    for (Node* node : nodes) {
+        unsigned long index = hashCode(string(node->key));
+        node->value = index;
+        node->next = nullptr;
+        if (tails[index] == nullptr) buckets[index].head = node;
+        else {
+            tails[index]->next = node;
+            collisions++;
+        }
+        tails[index] = node;
+        buckets[index].size += node->freq;
+    }
+    rebuildHeap();
+    myHeap->heapify();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Using hash_code function " << function << (function == 7 ? " (keyed SipHash)" : "") << ", rehashed "
+         << nodes.size() << " words in " << elapsed * 1000 << "ms; collisions: " << collisions
+         << ", longest chain: " << longestChain() << endl;
+}
+
+unsigned int HashTable::longestChain(){
+    unsigned int longest = 0;
+    for (unsigned int i = 0; i < capacity; i++) {
+        unsigned int length = 0;
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) length++;
+        longest = max(longest, length);
+    }
+    return longest;
+}
+
+// Lowercase words that hash_code function 1 sends to bucket target of a table with this
+// capacity. Words are ten letters, short enough that the polynomial never overflows, so
+// hash mod capacity is linear: a random six-letter prefix fixes most of it and a four-letter
+// suffix looked up by residue supplies the rest.
+static vector<string> collidingWords(unsigned int count, unsigned long capacity, unsigned long target)
+{
+    const unsigned long SUFFIXES = 26 * 26 * 26 * 26;
+    vector<int> suffix_of(capacity, -1);
+    for (unsigned long s = 0; s < SUFFIXES; s++) {
+        unsigned long h = 0;
+        for (unsigned long rest = s, i = 0; i < 4; i++, rest /= 26) h = h * 31 + ('a' + rest % 26);
+        suffix_of[h % capacity] = s;
+    }
+    const unsigned long SHIFT = 31UL * 31 * 31 * 31 % capacity;
+    mt19937_64 random(12345);
+    vector<string> words;
+    while (words.size() < count) {
+        string word(10, 'a');
+        unsigned long h = 0;
+        for (int i = 0; i < 6; i++) {
+            word[i] = 'a' + random() % 26;
+            h = h * 31 + word[i];
+        }
+        int s = suffix_of[(target + capacity - h % capacity * SHIFT % capacity) % capacity];
+        if (s < 0) continue;
+        for (int i = 0; i < 4; i++, s /= 26) word[6 + i] = 'a' + s % 26;
+        words.push_back(word);
+    }
+    // A prefix can repeat; duplicates would only be counted, not chained
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+void HashTable::benchmarkHashing(unsigned int count){
+    if (count == 0) throw std::invalid_argument("Usage: hash_bench [words]");
+    vector<string> attack = collidingWords(count, capacity, 0);
+    shuffle(attack.begin(), attack.end(), mt19937_64(1));
+    // Normal text: the imported vocabulary, or random words when nothing is imported
+    vector<string> normal;
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) normal.push_back(string(node->key));
+    }
+    if (normal.empty()) {
+        mt19937_64 random(7);
+        for (unsigned int i = 0; i < count; i++) {
+            string word(3 + random() % 8, 'a');
+            for (char& c : word) c = 'a' + random() % 26;
+            normal.push_back(word);
+        }
+    }
+    auto insertAll = [this](int function, const vector<string>& words, size_t n, unsigned int& chain) {
+        HashTable table(capacity);
+        table.hash_code_function = function;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) table.insert(words[i]);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        chain = table.longestChain();
+        return elapsed * 1e9 / n;
+    };
+    cout << "Crafted words that function 1 sends to one bucket, inserted into an empty table:" << endl;
+    cout << setw(10) << "words" << setw(12) << "function" << setw(16) << "ns per insert" << setw(16) << "longest chain" << endl;
+    for (size_t n = attack.size() / 4; n <= attack.size() && n > 0; n *= 2) {
+        for (int function : { 1, 7 }) {
+            unsigned int chain;
+            double ns = insertAll(function, attack, n, chain);
+            cout << setw(10) << n << setw(12) << function << setw(16) << fixed << setprecision(0) << ns
+                 << setw(16) << chain << endl;
+        }
+    }
+    cout << "Normal words (" << normal.size() << " unique):" << endl;
+    for (int function : { 1, 7 }) {
+        unsigned int chain;
+        double ns = insertAll(function, normal, normal.size(), chain);
+        int saved = hash_code_function;
+        hash_code_function = function;
+        auto start = chrono::steady_clock::now();
+        unsigned long sink = 0;
+        for (const string& word : normal) sink += hashCode(word);
+        double hash_ns = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / normal.size();
+        hash_code_function = saved;
+        volatile unsigned long keep = sink;     // the hashes must not be optimized away
+        (void)keep;
+        cout << "  function " << function << ": " << setprecision(0) << ns << " ns per insert, " << setprecision(1) << hash_ns
+             << " ns per hashCode, longest chain " << chain << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
 
 unsigned int HashTable::getCollisions()
 {
@@ -79,23 +269,30 @@ unsigned int HashTable::getCollisions()
 
 unsigned int HashTable::getUniqueWords()
 {
+    if (spilled()) return spill->getUniqueWords();
+    if (dictionary != nullptr) return dictionary->getUniqueWords();
     return unique_words;
 }
 
 unsigned int HashTable::getTotalWords()
 {
+    if (spilled()) return spill->getTotalWords();
+    if (dictionary != nullptr) return dictionary->getTotalWords();
     return total_words;
 }
 
 void HashTable::insert(string word)
 {
+    if (dictionary != nullptr) expandDictionary();
     unsigned long index = hashCode(word);
     // Search for the word in the linked list at the bucket
     Node* foundNode = buckets[index].find(word);
     if (foundNode == nullptr){
         // Word does not exist, insert it
-        buckets[index].insert(word, index);
+        buckets[index].insert(word, index, arena);
         unique_words++;
+        memory_used += wordFootprint(word);
+        if (speller != nullptr) speller->add(word);
         myHeap->insert(&buckets[index]);
         if (buckets[index].getSize() > 1) {
             collisions++;   // Increment collision count
@@ -113,10 +310,44 @@ void HashTable::insert(string word)
     else {
         // Increment collision count if other distinct keys exist in the bucket
             collisions++;
-            buckets[index].insert(word, index);
+            buckets[index].insert(word, index, arena);
         }
 
     total_words++;
+    if (window != nullptr) window->add(word);
+    if (cooccur != nullptr) cooccur->add(word);
+    // Leave an eighth of the budget for the run writer's buffer
+    if (spill != nullptr && memory_used > spill->getBudget() - spill->getBudget() / 8) spillRun();
+}
+
+void HashTable::insert(string word, unsigned int count)
+{
+    if (count == 0) return;
+    if (dictionary != nullptr) expandDictionary();
+    unsigned long index = hashCode(word);
+    Node* foundNode = buckets[index].find(word);
+    if (foundNode == nullptr){
+        buckets[index].insert(word, index, arena);
+        unique_words++;
+        memory_used += wordFootprint(word);
+        if (speller != nullptr) speller->add(word);
+        if (buckets[index].getSize() > 1) {
+            collisions++;   // Increment collision count
+        }
+        // Keep the bucket size in step with repeated single inserts
+        foundNode = buckets[index].find(word);
+        foundNode->freq = count;
+        buckets[index].size += count - 1;
+        myHeap->insert(&buckets[index]);
+    }
+    else {
+        // Heap order is restored by finishImport once the batch is merged
+        foundNode->freq += count;
+        buckets[index].size += count;
+    }
+    total_words += count;
+    // Merged or replayed counts have no token order, so they stay out of the window
+    if (spill != nullptr && memory_used > spill->getBudget() - spill->getBudget() / 8) spillRun();
 }
 
 int HashTable::find_freq(string word)
@@ -125,6 +356,8 @@ int HashTable::find_freq(string word)
         cout << "Error: Please try again. ";
         return 0;
     }
+    if (spilled()) return spill->find_freq(word);
+    if (dictionary != nullptr) return dictionary->find_freq(word);
     unsigned long index = hashCode(word);
     Node* word_node =  buckets[index].find(word);
     if (word_node == nullptr) { return 0; } // No such word found
@@ -134,51 +367,311 @@ int HashTable::find_freq(string word)
 }
 
 void HashTable::import(string path){
+    // Compressed corpora are decoded on the pipeline's reader thread, never to disk
+    if (InputStream::detect(path) != InputStream::PLAIN) {
+        importPipelined(path);
+        return;
+    }
     ifstream file(path);
     if (!file.is_open()){
         cout << "Unable to open file: " + path << endl;
         return;
     }
-    string line, word;
-    // Define a string containing all punctuation to be removed
-    const string punctuation = ".,!?;\"'“”‘’"; //#[]:()-
+    string line;
     while (getline(file, line))
     {
-        stringstream ss(line);
-        while (ss >> word)
-        {
-            // Normalize word: remove leading/trailing punctuation
-            size_t start = 0, end = word.size() - 1;
-
-            // Remove punctuation from the start
-            while (start < word.size() && punctuation.find(word[start]) != string::npos)
-            {
-                ++start;
+        // Normalize words: remove leading/trailing punctuation and convert to lowercase
+        Tokenizer::forEachWord(line.data(), line.data() + line.size(), [this](const string& word) {
+            insert(word);
+        });
+    }
+    file.close();
+    finishImport();
+}
+
+void HashTable::importPipelined(string path){
+    ImportPipeline pipeline(*this);
+    bool ok = pipeline.run(path);
+    pipeline.printStats();
+    if (ok) finishImport();
+    else myHeap->heapify();     // keep find_max consistent with what was counted
+}
+
+// Hand every word of a whole file to emit, through its decoder (compressed files cannot be split into byte ranges)
+static void streamWords(const string& path, const function<void(const string&)>& emit)
+{
+    InputStream* input = InputStream::open(path);
+    if (input == nullptr) return;
+    const size_t BLOCK_SIZE = 1 << 20;
+    string block;
+    while (true) {
+        size_t kept = block.size();
+        block.resize(kept + BLOCK_SIZE);
+        block.resize(kept + input->read(&block[kept], BLOCK_SIZE));
+        if (block.size() == kept) break;
+        size_t cut = block.size();
+        while (cut > 0 && !Tokenizer::isSpace(block[cut - 1])) cut--;
+        Tokenizer::forEachWord(block.data(), block.data() + cut, emit);
+        block.erase(0, cut);
+    }
+    Tokenizer::forEachWord(block.data(), block.data() + block.size(), emit);
+    if (input->failed()) cout << "Input is corrupt: " + path << endl;
+    delete input;
+}
+
+// Collect the files named by a directory (recursively) or a glob pattern, in a stable order
+static vector<string> listFiles(const string& pattern)
+{
+    vector<string> files;
+    if (pattern.find_first_of("*?[") != string::npos) {
+        glob_t matches;
+        if (glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; i++) {
+                if (filesystem::is_regular_file(matches.gl_pathv[i])) files.push_back(matches.gl_pathv[i]);
+            }
+        }
+        globfree(&matches);
+    }
+    else if (filesystem::is_directory(pattern)) {
+        error_code ec;
+        for (auto it = filesystem::recursive_directory_iterator(pattern, ec); it != filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (ec) break;
+            if (it->is_regular_file()) files.push_back(it->path().string());
+        }
+    }
+    else if (filesystem::is_regular_file(pattern)) {
+        files.push_back(pattern);
+    }
+    sort(files.begin(), files.end());
+    return files;
+}
+
+// Count the words of bytes [begin,end) of a file. A word that straddles begin belongs to
+// the previous chunk, and a word that straddles end is read to its end; a word starting
+// exactly at end belongs to the next chunk.
+static void countChunk(const string& path, size_t begin, size_t end, unordered_map<string, unsigned int>& counts)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return;
+    size_t from = (begin > 0) ? begin - 1 : 0;     // one byte of look-behind
+    string buffer(end - from, '\0');
+    file.seekg(from);
+    file.read(&buffer[0], buffer.size());
+    buffer.resize(file.gcount());
+    char c;
+    if (!buffer.empty() && !Tokenizer::isSpace(buffer.back())) {     // only a word already started may run past end
+        while (file.get(c) && !Tokenizer::isSpace(c)) buffer.push_back(c);
+    }
+
+    const char* p = buffer.data();
+    const char* stop = p + buffer.size();
+    if (begin > 0 && p < stop) {
+        if (Tokenizer::isSpace(*p)) ++p;
+        else while (p < stop && !Tokenizer::isSpace(*p)) ++p;
+    }
+    Tokenizer::forEachWord(p, stop, [&counts](const string& word) {
+        counts[word]++;
+    });
+}
+
+void HashTable::importDir(string pattern){
+    const size_t CHUNK_SIZE = 8 << 20;              // files above this are split into 8MB chunks
+    vector<string> files = listFiles(pattern);
+    if (files.empty()) {
+        cout << "No files found for: " + pattern << endl;
+        return;
+    }
+    if (spill != nullptr || cooccur != nullptr || window != nullptr) {
+        // Per-worker counts would grow past the spill budget and lose the word order that
+        // pairs and the window need: count one file at a time into the table instead
+        for (const string& path : files) {
+            streamWords(path, [this](const string& word) { insert(word); });
+            if (cooccur != nullptr) cooccur->endDocument();
+        }
+        cout << "Imported " << files.size() << " files one at a time (" << (spill != nullptr ? "spill mode" : cooccur != nullptr ? "counting pairs" : "window counting") << ")" << endl;
+        finishImport();
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    ThreadPool pool(thread::hardware_concurrency());
+    // One partial count per worker, so tokenizing never takes a lock
+    vector<unordered_map<string, unsigned int>> partial(pool.size());
+    atomic<unsigned long> files_done(0), bytes_done(0), chunks(0);
+
+    for (const string& path : files) {
+        pool.submit([&, path](int worker) {
+            error_code ec;
+            size_t size = filesystem::file_size(path, ec);
+            if (ec) { files_done++; return; }
+            if (InputStream::detect(path) != InputStream::PLAIN) {
+                streamWords(path, [&counts = partial[worker]](const string& word) { counts[word]++; });
+                bytes_done += size;
+                chunks++;
+                files_done++;
+                return;
             }
-            // Remove punctuation from the end
-            while (end > start && punctuation.find(word[end]) != string::npos)
-            {
-                --end;
+            if (size <= CHUNK_SIZE) {
+                countChunk(path, 0, size, partial[worker]);
+                bytes_done += size;
+                chunks++;
+                files_done++;
+                return;
             }
-            // Extract the cleaned word
-            string cleanedWord = word.substr(start, end - start + 1);
-            // Convert to lowercase
-            for (char &c : cleanedWord)
-            {
-                c = tolower(c);
+            size_t parts = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            // Split big files into chunk tasks on this worker's deque; idle workers steal them
+            auto remaining = make_shared<atomic<size_t>>(parts);
+            for (size_t i = 0; i < parts; i++) {
+                size_t begin = i * CHUNK_SIZE, end = min(size, begin + CHUNK_SIZE);
+                pool.submit([&, path, begin, end, remaining](int worker) {
+                    countChunk(path, begin, end, partial[worker]);
+                    bytes_done += end - begin;
+                    chunks++;
+                    if (--(*remaining) == 0) files_done++;
+                });
             }
-            // Insert the cleaned word if it is not empty
-            if (!cleanedWord.empty())
-            {
-                insert(cleanedWord);
+        });
+    }
+    while (!pool.waitFor(chrono::milliseconds(1000))) {
+        cout << "Progress: " << files_done << "/" << files.size() << " files, "
+             << bytes_done / (1 << 20) << " MB" << endl;
+    }
+    double scan = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Merge the per-worker counts into the table
+    for (auto& counts : partial) {
+        for (auto& entry : counts) insert(entry.first, entry.second);
+        counts.clear();
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Imported " << files_done << " files (" << bytes_done / (1 << 20) << " MB, " << chunks
+         << " chunks) in " << elapsed << "s using " << pool.size() << " workers" << endl;
+    pool.printStats(scan);
+    finishImport();
+}
+
+void HashTable::reimport(string pattern){
+    if (spill != nullptr) throw std::runtime_error("Incremental re-import is not available in spill mode");
+    if (cooccur != nullptr) throw std::runtime_error("Incremental re-import cannot take back word pairs; use context off first");
+    if (dictionary != nullptr) expandDictionary();
+    vector<string> files = listFiles(pattern);
+    auto start = chrono::steady_clock::now();
+
+    // Only files whose size or mtime moved are read at all
+    struct Change { string path; FileRecord record; bool same_bytes; };
+    vector<Change> changes;
+    unsigned long unchanged = 0;
+    for (const string& path : files) {
+        FileRecord record;
+        if (!Manifest::stat(path, record.size, record.mtime)) continue;
+        FileRecord* old = manifest->find(path);
+        if (old != nullptr && old->size == record.size && old->mtime == record.mtime) {
+            unchanged++;
+            continue;
+        }
+        changes.push_back(Change{ path, std::move(record), false });
+    }
+    // Hash, and count where the bytes differ, on the pool; the manifest is only read here
+    ThreadPool pool(thread::hardware_concurrency());
+    atomic<unsigned long> bytes_read(0);
+    for (Change& change : changes) {
+        pool.submit([&](int) {
+            change.record.hash = Manifest::hashFile(change.path);
+            FileRecord* old = manifest->find(change.path);
+            if (old != nullptr && old->hash == change.record.hash) {
+                change.same_bytes = true;
+                return;
             }
+            unordered_map<string, unsigned int> counts;
+            streamWords(change.path, [&counts](const string& word) { counts[word]++; });
+            change.record.counts.assign(counts.begin(), counts.end());
+            bytes_read += change.record.size;
+        });
+    }
+    pool.wait();
+
+    // Apply the differences: removed files, then every changed file's old and new counts
+    unsigned long added = 0, modified = 0, touched = 0, removed = 0;
+    bool words_left = false;
+    vector<string> listed = files;
+    for (const string& path : manifest->paths()) {
+        if (binary_search(listed.begin(), listed.end(), path) && filesystem::exists(path)) continue;
+        for (const WordCount& wc : manifest->find(path)->counts) words_left |= subtract(wc.first, wc.second);
+        manifest->erase(path);
+        removed++;
+    }
+    for (Change& change : changes) {
+        FileRecord* old = manifest->find(change.path);
+        if (change.same_bytes) {
+            old->mtime = change.record.mtime;
+            touched++;
+            continue;
         }
+        if (old != nullptr) {
+            for (const WordCount& wc : old->counts) words_left |= subtract(wc.first, wc.second);
+            modified++;
+        }
+        else added++;
+        manifest->update(change.path, std::move(change.record));
     }
-    file.close();
-    for (int i = 1; i < unique_words/2; i++){
-        myHeap->bubbledown(i);
-        myHeap->bubbleup(i);
+    if (words_left) rebuildHeap();
+    for (Change& change : changes) {
+        if (change.same_bytes) continue;
+        for (const WordCount& wc : manifest->find(change.path)->counts) insert(wc.first, wc.second);
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Re-imported " << files.size() << " files in " << elapsed << "s: " << added << " new, "
+         << modified << " changed, " << removed << " removed, " << unchanged + touched << " unchanged ("
+         << touched << " with only a new mtime); read " << bytes_read / (1 << 20) << " MB" << endl;
+    finishImport();
+}
+
+// Take back count occurrences of word, as the mirror image of insert(word, count)
+bool HashTable::subtract(const string& word, unsigned int count){
+    unsigned long index = hashCode(word);
+    Node* node = buckets[index].find(word);
+    if (node == nullptr) return false;
+    unsigned int taken = min<unsigned int>(count, node->freq);
+    node->freq -= taken;
+    buckets[index].size -= taken;
+    total_words -= taken;
+    if (node->freq > 0) return false;
+    // Arena nodes are only unlinked; their memory comes back on the next reset
+    buckets[index].remove(word, arena == nullptr);
+    unique_words--;
+    memory_used -= wordFootprint(word);
+    if (buckets[index].head != nullptr) collisions--;
+    return true;
+}
+
+void HashTable::rebuildHeap(){
+    delete myHeap;
+    myHeap = new Heap(arena != nullptr ? (std::pmr::memory_resource*)arena : std::pmr::get_default_resource());
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) {
+            myHeap->insert(&buckets[i]);
+        }
     }
+}
+
+void HashTable::finishImport(){
+    if (cooccur != nullptr) {
+        cooccur->endDocument();
+        cout << "Counted " << cooccur->getUpdates() << " word pair updates, " << cooccur->getPairs() << " distinct pairs ("
+             << cooccur->memoryUsed() / (1 << 20) << " MB)" << endl;
+    }
+    if (spill != nullptr && (spill->hasRuns() || spill->isMerged())) {
+        // Whatever is still in memory becomes the last run, then every run is merged
+        auto start = chrono::steady_clock::now();
+        if (unique_words > 0) spillRun();
+        spill->merge();
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Done! Merged the spilled runs in " << elapsed << "s" << endl << endl;
+        cout << "The number of unique words is:" << spill->getUniqueWords() << endl;
+        cout << "The total number of words is:" << spill->getTotalWords() << endl;
+        return;
+    }
+    myHeap->heapify();
     cout << "Done!" << endl << endl;
     cout << "The number of collisions is:" << collisions << endl;
     cout << "The number of unique words is:" << unique_words << endl;
@@ -187,11 +680,377 @@ void HashTable::import(string path){
 }
 
 string HashTable::findMax(){	//Gives the max from maxheap
+    if (spilled()) return spill->findMax();
+    if (dictionary != nullptr) return dictionary->findMax();
     return myHeap->getMax();
 } 				
 
+vector<WordCount> HashTable::topK(unsigned int k){
+    TopK best(k);
+    if (spilled()) {
+        spill->forEach([&best](const string& word, uint64_t count) { best.offer(word, count); });
+        return best.result();
+    }
+    if (dictionary != nullptr) {
+        dictionary->forEach([&best](string_view word, unsigned int count) { best.offer(word, count); });
+        return best.result();
+    }
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) {
+            best.offer(node->key, node->freq);
+        }
+    }
+    return best.result();
+}
+
+void HashTable::setWindow(string spec){
+    stringstream ss(spec);
+    string mode;
+    long size = 0;
+    ss >> mode >> size;
+    if (mode == "off") {
+        delete window;
+        window = nullptr;
+        cout << "Window counting disabled" << endl;
+        return;
+    }
+    if ((mode != "tokens" && mode != "minutes") || size <= 0) {
+        throw std::invalid_argument("Usage: window tokens <N> | window minutes <N> | window off");
+    }
+    // Counting starts fresh: earlier words have no position in the new window
+    delete window;
+    window = new WindowCounter(mode == "tokens" ? WindowCounter::TOKENS : WindowCounter::MINUTES, size);
+    cout << "Counting the " << window->describe() << " from now on" << endl;
+}
+
+int HashTable::find_freq_window(string word){
+    if (window == nullptr) throw std::runtime_error("No window is set. Use: window tokens <N> | window minutes <N>");
+    return window->find_freq(word);
+}
+
+vector<WordCount> HashTable::topK_window(unsigned int k){
+    if (window == nullptr) throw std::runtime_error("No window is set. Use: window tokens <N> | window minutes <N>");
+    return window->topK(k);
+}
+
+string HashTable::describeWindow(){
+    return window == nullptr ? "all time" : window->describe();
+}
+
+void HashTable::setContext(string spec){
+    if (spec == "off") {
+        delete cooccur;
+        cooccur = nullptr;
+        cout << "Word pair counting disabled" << endl;
+        return;
+    }
+    stringstream ss(spec);
+    int k = 0;
+    ss >> k;
+    if (k <= 0) throw std::invalid_argument("Usage: context <k> | context off");
+    // Like a window, pair counting starts with the next import
+    delete cooccur;
+    cooccur = new CooccurrenceCounter(k);
+    cout << "Counting word pairs up to " << k << " tokens apart from now on" << endl;
+}
+
+vector<WordCount> HashTable::cooccurring(string word, unsigned int k){
+    if (cooccur == nullptr) throw std::runtime_error("No context is set. Use: context <k>");
+    return cooccur->partners(word, k);
+}
+
+vector<Suggestion> HashTable::suggest(string word, unsigned int k){
+    if (speller == nullptr) {
+        // Built from the whole vocabulary once; insert adds every later new word to it
+        auto start = chrono::steady_clock::now();
+        speller = new SpellIndex;
+        if (spilled()) spill->forEach([this](const string& w, uint64_t) { speller->add(w); });
+        if (dictionary != nullptr) dictionary->forEach([this](string_view w, unsigned int) { speller->add(string(w)); });
+        for (unsigned int i = 0; i < capacity; i++) {
+            for (Node* node = buckets[i].head; node != nullptr; node = node->next) speller->add(string(node->key));
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Indexed " << speller->size() << " words for suggestions (" << speller->entries() << " deletes) in "
+             << elapsed << "s" << endl;
+    }
+    vector<Suggestion> found;
+    unordered_set<string> listed;      // a word re-added after a spill or reimport is indexed twice
+    for (auto& candidate : speller->near(word)) {
+        if (candidate.second == 0 || !listed.insert(candidate.first).second) continue;
+        // Frequencies come from the table, so words that reimport took out drop away here
+        unsigned int freq = find_freq(candidate.first);
+        if (freq > 0) found.push_back(Suggestion{ candidate.first, freq, candidate.second });
+    }
+    sort(found.begin(), found.end(), [](const Suggestion& a, const Suggestion& b) {
+        if (a.freq != b.freq) return a.freq > b.freq;
+        if (a.distance != b.distance) return a.distance < b.distance;
+        return a.word < b.word;
+    });
+    if (found.size() > k) found.resize(k);
+    return found;
+}
+
+void HashTable::exportData(string path, string order){
+    if (order != "freq" && order != "alpha") {
+        throw std::invalid_argument("Usage: export <path> [--by freq|alpha]");
+    }
+    if (spilled() && order == "freq") {
+        throw std::runtime_error("Counts have spilled to disk; only export <path> --by alpha is available");
+    }
+    BufferedWriter out(path);
+    if (!out.isOpen()) {
+        cout << "Unable to open file: " + path << endl;
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    if (spilled()) {
+        // The merged runs are already alphabetical: stream them straight out
+        unsigned long words = 0;
+        spill->forEach([&out, &words](const string& word, uint64_t count) {
+            out.write(word);
+            out.write('\t');
+            out.write((unsigned long)count);
+            out.write('\n');
+            words++;
+        });
+        if (!out.close()) {
+            cout << "Error while writing: " + path << endl;
+            return;
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Exported " << words << " words by alpha to " << path << " in " << elapsed << "s (from spilled runs)" << endl;
+        return;
+    }
+    // Gather pointers to the stored keys; the words themselves are not copied
+    vector<WordEntry> entries;
+    entries.reserve(unique_words);
+    vector<string> decoded;         // compacted words have no key to point at, so they are decoded here
+    if (dictionary != nullptr) {
+        decoded.reserve(dictionary->getUniqueWords());  // never reallocates, so the views stay valid
+        dictionary->forEach([&](string_view word, unsigned int freq) {
+            decoded.emplace_back(word);
+            entries.push_back(WordEntry{ decoded.back(), freq });
+        });
+    }
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) {
+            entries.push_back(WordEntry{ node->key, (unsigned int)node->freq });
+        }
+    }
+    auto gathered = chrono::steady_clock::now();
+
+    ThreadPool pool(thread::hardware_concurrency());
+    if (order == "freq") radixSortByFreq(entries, pool);    // ties keep table order
+    else sortAlphabetically(entries, pool);
+    auto sorted = chrono::steady_clock::now();
+
+    for (const WordEntry& e : entries) {
+        out.write(e.word);
+        out.write('\t');
+        out.write((unsigned long)e.freq);
+        out.write('\n');
+    }
+    if (!out.close()) {
+        cout << "Error while writing: " + path << endl;
+        return;
+    }
+    auto written = chrono::steady_clock::now();
+    auto seconds = [](chrono::steady_clock::duration d) { return chrono::duration<double>(d).count(); };
+    cout << "Exported " << entries.size() << " words by " << order << " to " << path << " in "
+         << seconds(written - start) << "s (gather " << seconds(gathered - start) << "s, sort "
+         << seconds(sorted - gathered) << "s, write " << seconds(written - sorted) << "s)" << endl;
+}
+
+void HashTable::clearTable(){
+    delete myHeap;
+    if (arena != nullptr) {
+        // Nodes live in the arena: unlink them instead of deleting them one by one
+        for (unsigned int i = 0; i < capacity; i++) {
+            buckets[i].head = nullptr;
+            buckets[i].size = 0;
+        }
+        arena->reset();
+    }
+    else {
+        for (unsigned int i = 0; i < capacity; i++) {
+            buckets[i].clear();
+        }
+    }
+    myHeap = new Heap(arena != nullptr ? (std::pmr::memory_resource*)arena : std::pmr::get_default_resource());
+    collisions = 0;
+    unique_words = 0;
+    total_words = 0;
+    memory_used = capacity * sizeof(LinkedList);
+}
+
+void HashTable::clear(){
+    clearTable();
+    manifest->clear();
+    if (spill != nullptr) spill->clear();
+    if (window != nullptr) window->clear();
+    if (cooccur != nullptr) cooccur->clear();
+    delete speller;
+    speller = nullptr;
+    delete dictionary;
+    dictionary = nullptr;
+}
+
+void HashTable::compact(){
+    if (spill != nullptr) throw std::runtime_error("Spilled counts are already compact on disk; compact is for in-memory tables");
+    if (dictionary != nullptr) {
+        cout << "Already compact" << endl;
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    vector<WordEntry> entries;
+    entries.reserve(unique_words);
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) {
+            entries.push_back(WordEntry{ node->key, (unsigned int)node->freq });
+        }
+    }
+    ThreadPool pool(thread::hardware_concurrency());
+    sortAlphabetically(entries, pool);
+    dictionary = new FrontCodedDictionary(entries);
+    entries = vector<WordEntry>();
+    size_t words = dictionary->getUniqueWords();
+
+    clearTable();
+    if (arena != nullptr) {
+        // A reset arena keeps its pages; a new one gives them back
+        delete myHeap;
+        delete arena;
+        arena = new Arena;
+        myHeap = new Heap(arena);
+    }
+#ifdef __GLIBC__
+    malloc_trim(0);     // hand the freed nodes back to the OS rather than keeping them in malloc's free lists
+#endif
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t bytes = dictionary->memoryUsed();
+    cout << "Compacted " << words << " words into " << bytes / 1024 << " KB (" << fixed << setprecision(1)
+         << (words > 0 ? (double)bytes / words : 0) << " bytes per word) in " << setprecision(3) << elapsed << "s" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6) << "The table is read-only until the next import, which expands it again" << endl;
+}
+
+void HashTable::expandDictionary(){
+    auto start = chrono::steady_clock::now();
+    FrontCodedDictionary* compacted = dictionary;
+    dictionary = nullptr;
+    // These words are not new: keep them out of the suggestion index
+    SpellIndex* saved_speller = speller;
+    speller = nullptr;
+    compacted->forEach([this](string_view word, unsigned int freq) { insert(string(word), freq); });
+    speller = saved_speller;
+    delete compacted;
+    myHeap->heapify();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Expanded " << unique_words << " compacted words back into the table in " << elapsed << "s" << endl;
+}
+
+void HashTable::spillRun(){
+    vector<WordEntry> entries;
+    entries.reserve(unique_words);
+    for (unsigned int i = 0; i < capacity; i++) {
+        for (Node* node = buckets[i].head; node != nullptr; node = node->next) {
+            entries.push_back(WordEntry{ node->key, (unsigned int)node->freq });
+        }
+    }
+    ThreadPool pool(thread::hardware_concurrency());
+    sortAlphabetically(entries, pool);
+    spill->writeRun(entries);
+    entries = vector<WordEntry>();
+    clearTable();
+}
+
+bool HashTable::spilled(){
+    return spill != nullptr && spill->isMerged();
+}
+
+void HashTable::setSpill(string spec){
+    if (spec == "off") {
+        if (spill == nullptr) {
+            cout << "Spill mode is already off" << endl;
+            return;
+        }
+        if (spill->isMerged() || spill->hasRuns()) {
+            throw std::runtime_error("Counts have spilled to disk; use reset before turning spill mode off");
+        }
+        delete spill;
+        spill = nullptr;
+        cout << "Spill mode off, counting in memory only" << endl;
+        return;
+    }
+    stringstream ss(spec);
+    long megabytes = 0;
+    ss >> megabytes;
+    if (megabytes <= 0) throw std::invalid_argument("Usage: spill <MB> | spill off");
+    // The bucket array is allocated up front, so the budget has to leave room for words beyond it
+    size_t budget = (size_t)megabytes << 20;
+    size_t minimum = capacity * sizeof(LinkedList) + (8 << 20);
+    if (budget < minimum) {
+        throw std::invalid_argument("The budget must be at least " + to_string((minimum >> 20) + 1) + " MB for this table");
+    }
+    if (spill != nullptr && (spill->isMerged() || spill->hasRuns())) {
+        throw std::runtime_error("Counts have spilled to disk; use reset before changing the budget");
+    }
+    delete spill;
+    spill = new SpillStore(budget);
+    cout << "Counts spill to disk once the table holds about " << megabytes << " MB" << endl;
+    if (memory_used > budget - budget / 8) spillRun();
+}
+
+void HashTable::reset(){
+    auto start = chrono::steady_clock::now();
+    unsigned int words = unique_words;
+    clear();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Discarded " << words << " unique words in " << elapsed * 1000 << "ms";
+    if (arena != nullptr) cout << " (" << arena->reserved() / (1 << 20) << " MB of arena pages kept for reuse)";
+    cout << endl;
+}
+
+void HashTable::setMemoryMode(string mode){
+    if (mode != "arena" && mode != "heap") {
+        throw std::invalid_argument("Usage: memory arena|heap");
+    }
+    if ((mode == "arena") == (arena != nullptr)) {
+        cout << "Already in " << mode << " mode" << endl;
+        return;
+    }
+    clear();
+    if (mode == "arena") {
+        arena = new Arena;
+        delete myHeap;
+        myHeap = new Heap(arena);
+    }
+    else {
+        delete myHeap;
+        delete arena;
+        arena = nullptr;
+        myHeap = new Heap;
+    }
+    cout << "Switched to " << mode << " mode, the table is empty" << endl;
+}
+
 HashTable::~HashTable()
 {
+    delete myHeap;
+    if (arena != nullptr) {
+        // Let ~LinkedList see empty lists; the arena owns the nodes
+        for (unsigned int i = 0; i < capacity; i++) {
+            buckets[i].head = nullptr;
+            buckets[i].size = 0;
+        }
+    }
     delete[] buckets; // Free the array of linked lists
+    delete window;
+    delete spill;
+    delete manifest;
+    delete cooccur;
+    delete speller;
+    delete dictionary;
+    delete arena;
 }
 
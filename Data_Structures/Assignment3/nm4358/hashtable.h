@@ -1,13 +1,21 @@
 
-#ifndef _HASHTABLE_H
-#define _HASHTABLE_H
+#ifndef _HASH_TABLE_H
+#define _HASH_TABLE_H
 #include <string>
 #include "linkedlist.h"
 #include "maxheap.h"
+#include "topk.h"
+#include "spellindex.h"
 using std::string;
 
 class LinkedList;
 class Heap;
+class WindowCounter;
+class Arena;
+class SpillStore;
+class Manifest;
+class CooccurrenceCounter;
+class FrontCodedDictionary;
 
 class HashTable
 {
@@ -18,20 +26,56 @@ class HashTable
 		unsigned int unique_words;					// Number of unique words in the hashtable
 		unsigned int total_words;					// Total number of words in the hashtable
 		int hash_code_function;						// Selected Hash_code function
+		WindowCounter *window;						// Recent-words counter, nullptr when no window is set
+		Arena *arena;								// Keys, nodes and heap storage in arena mode, nullptr otherwise
+		SpillStore *spill;							// Sorted runs on disk in spill mode, nullptr otherwise
+		size_t memory_used;							// Estimated bytes held by the table, checked against the spill budget
+		Manifest *manifest;							// Files counted by reimport, with what each one added
+		CooccurrenceCounter *cooccur;				// Word pair counts, nullptr unless a context is set
+		SpellIndex *speller;						// Deletion index for suggest, built on first use
+		FrontCodedDictionary *dictionary;			// Every word after compact, nullptr while the table holds them
 
+		void finishImport();						// restore the heap and print the import summary
+		void clear();								// drop every word and count
+		void clearTable();							// drop the in-memory words, keep the window and spilled runs
+		void spillRun();							// write the table as a sorted run and empty it
+		bool spilled();								// true once queries are answered from the merged runs
+		bool subtract(const string& word, unsigned int count);	// take back occurrences, true if the word left the table
+		void rebuildHeap();							// one heap entry per word again, after words were removed
+		void expandDictionary();					// move the compacted words back into the table
+		unsigned int longestChain();
 
 	
 	public:
 		Heap *myHeap;
 		HashTable(int capacity);
 		unsigned long hashCode(string key);
+		void setHashFunction(int function);			// 1-6 as before, 7 is keyed SipHash; existing words are rehashed
+		void benchmarkHashing(unsigned int words);	// chain lengths and insert speed under a collision attack
 		unsigned int getCollisions();
 		unsigned int getUniqueWords();
 		unsigned int getTotalWords();
 		void import(string path);
+		void importPipelined(string path);			// import with reading, tokenizing and counting overlapped
+		void importDir(string pattern);				// import every file of a directory or glob on a thread pool
+		void reimport(string pattern);				// bring the counts in line with a directory or glob, reading only changed files
 		void insert(string word);
+		void insert(string word, unsigned int count);	// add count occurrences of word at once, outside the window
 		int find_freq(string word);						//return the frequency of a word
 		string findMax(); 					//Gives the max from maxheap
+		vector<WordCount> topK(unsigned int k);		// k most frequent words of all time
+		void setWindow(string spec);				// "tokens <N>", "minutes <N>" or "off"
+		int find_freq_window(string word);			// frequency of a word inside the window
+		vector<WordCount> topK_window(unsigned int k);	// k most frequent words inside the window
+		string describeWindow();
+		void setContext(string spec);				// "<k>" counts word pairs up to k tokens apart, "off" stops
+		vector<WordCount> cooccurring(string word, unsigned int k);	// k words most often within the context of word
+		vector<Suggestion> suggest(string word, unsigned int k);	// k most frequent words within edit distance 1-2
+		void reset();								// forget everything before the next import; in arena mode only the buckets are walked, not the words
+		void setMemoryMode(string mode);			// "arena" or "heap", starts from an empty table
+		void exportData(string path, string order);	// write every word and its frequency, order is "freq" or "alpha"
+		void compact();								// move every word into a front-coded dictionary, read-only until the next import
+		void setSpill(string spec);					// "<MB>" memory budget before counts spill to disk, or "off"
 		~HashTable();
 };
 #endif
\ No newline at end of file
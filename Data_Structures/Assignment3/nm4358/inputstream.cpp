@@ -0,0 +1,173 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Plain and compressed (.gz/.zst) input read in large blocks
+//============================================================================
+#include "inputstream.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+using namespace std;
+
+//====================================
+class PlainInput : public InputStream
+{
+	private:
+		ifstream file;
+	public:
+		PlainInput(const string& path) : file(path, ios::binary) {}
+		bool isOpen() const { return file.is_open(); }
+		size_t read(char* buffer, size_t size)
+		{
+			file.read(buffer, size);
+			return file.gcount();
+		}
+		bool failed() const { return false; }
+};
+//====================================
+// gzread handles concatenated members and checks every CRC itself
+class GzipInput : public InputStream
+{
+	private:
+		gzFile file;
+		bool error;
+	public:
+		GzipInput(const string& path) : file(gzopen(path.c_str(), "rb")), error(false)
+		{
+			if (file) gzbuffer(file, 1 << 20);
+		}
+		~GzipInput()
+		{
+			if (file) gzclose(file);
+		}
+		bool isOpen() const { return file != nullptr; }
+		size_t read(char* buffer, size_t size)
+		{
+			if (error) return 0;
+			int got = gzread(file, buffer, size);
+			int code = Z_OK;
+			const char* message = gzerror(file, &code);
+			// A truncated stream ends with a short read and Z_BUF_ERROR instead of a failure
+			if (got < 0 || (got == 0 && code != Z_OK))
+			{
+				cout << "gzip error: " << message << endl;
+				error = true;
+				return 0;
+			}
+			return got;
+		}
+		bool failed() const { return error; }
+};
+//====================================
+#ifdef HAVE_ZSTD
+class ZstdInput : public InputStream
+{
+	private:
+		FILE* file;
+		ZSTD_DCtx* context;
+		vector<char> compressed;
+		ZSTD_inBuffer in;
+		size_t pending;			// 0 once the current frame is complete
+		bool error;
+	public:
+		ZstdInput(const string& path) : file(fopen(path.c_str(), "rb")), context(ZSTD_createDCtx()),
+			compressed(ZSTD_DStreamInSize()), in{compressed.data(), 0, 0}, pending(0), error(false) {}
+		~ZstdInput()
+		{
+			if (file) fclose(file);
+			ZSTD_freeDCtx(context);
+		}
+		bool isOpen() const { return file != nullptr; }
+		size_t read(char* buffer, size_t size)
+		{
+			ZSTD_outBuffer out = { buffer, size, 0 };
+			while (!error && out.pos < out.size)
+			{
+				if (in.pos == in.size)
+				{
+					in.size = fread(compressed.data(), 1, compressed.size(), file);
+					in.pos = 0;
+					if (in.size == 0)
+					{
+						// End of file in the middle of a frame
+						if (pending != 0)
+						{
+							cout << "zstd error: truncated input" << endl;
+							error = true;
+						}
+						break;
+					}
+				}
+				pending = ZSTD_decompressStream(context, &out, &in);
+				if (ZSTD_isError(pending))
+				{
+					cout << "zstd error: " << ZSTD_getErrorName(pending) << endl;
+					error = true;
+				}
+			}
+			return out.pos;
+		}
+		bool failed() const { return error; }
+};
+#endif
+//====================================
+InputStream::Format InputStream::detect(const string& path)
+{
+	unsigned char magic[4] = { 0, 0, 0, 0 };
+	ifstream file(path, ios::binary);
+	file.read((char*)magic, 4);
+	if (file.gcount() >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return GZIP;
+	if (file.gcount() == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) return ZSTD;
+	return PLAIN;
+}
+
+const char* InputStream::formatName(Format format)
+{
+	switch (format)
+	{
+		case GZIP: return "gzip";
+		case ZSTD: return "zstd";
+		default:   return "plain";
+	}
+}
+
+InputStream* InputStream::open(const string& path)
+{
+	switch (detect(path))
+	{
+		case GZIP:
+		{
+			GzipInput* input = new GzipInput(path);
+			if (input->isOpen()) return input;
+			delete input;
+			break;
+		}
+		case ZSTD:
+		{
+#ifdef HAVE_ZSTD
+			ZstdInput* input = new ZstdInput(path);
+			if (input->isOpen()) return input;
+			delete input;
+			break;
+#else
+			cout << "zstd input is not supported by this build: " + path << endl;
+			return nullptr;
+#endif
+		}
+		default:
+		{
+			PlainInput* input = new PlainInput(path);
+			if (input->isOpen()) return input;
+			delete input;
+		}
+	}
+	cout << "Unable to open file: " + path << endl;
+	return nullptr;
+}
@@ -0,0 +1,27 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Plain and compressed (.gz/.zst) input read in large blocks
+//============================================================================
+
+#ifndef _INPUTSTREAM_H
+#define _INPUTSTREAM_H
+#include <string>
+using std::string;
+
+class InputStream
+{
+	public:
+		enum Format { PLAIN, GZIP, ZSTD };
+		static Format detect(const string& path);		// from the magic bytes, not the file extension
+		static const char* formatName(Format format);
+		// Open path with the matching decoder; nullptr (and a message) if it cannot be read
+		static InputStream* open(const string& path);
+
+		virtual size_t read(char* buffer, size_t size) = 0;	// decoded bytes, 0 at the end of input
+		virtual bool failed() const = 0;					// true if the input turned out to be corrupt
+		virtual ~InputStream() {}
+};
+#endif
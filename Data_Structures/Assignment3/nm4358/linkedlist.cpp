@@ -8,11 +8,11 @@
 #include "linkedlist.h"
 
 // Node constructor
-Node::Node(string key, int value) : key(key), value(value), next(nullptr) {}
+Node::Node(string key, int value, std::pmr::memory_resource* memory) : key(key.data(), key.size(), memory), value(value), next(nullptr) {}
 
 // Getters for Node
 string Node::getKey() {
-    return key;
+    return string(key);
 }
 
 int Node::getValue() {
@@ -21,7 +21,7 @@ int Node::getValue() {
 
 // Setters for Node
 void Node::setKey(string key) {
-    this->key = key;
+    this->key.assign(key.data(), key.size());
 }
 
 void Node::setValue(int value) {
@@ -47,13 +47,13 @@ unsigned int LinkedList::getSize() const {
 }
 
 // Insert a new key-value pair into the linked list
-void LinkedList::insert(string key, int value) {
+void LinkedList::insert(string key, int value, std::pmr::memory_resource* arena) {
     Node* current = head;
     Node* prev = nullptr;
 
     // Traverse the list to check if the key already exists
     while (current != nullptr) {
-        if (current->key == key) {
+        if (current->key.compare(key) == 0) {
             current->value = value; // Update value if key exists
             return;
         }
@@ -62,7 +62,10 @@ void LinkedList::insert(string key, int value) {
     }
 
     // Key not found, create a new node
-    Node* newNode = new Node(key, value);
+    // Arena nodes are never deleted one by one: the owner discards the whole arena
+    Node* newNode;
+    if (arena != nullptr) newNode = new (arena->allocate(sizeof(Node), alignof(Node))) Node(key, value, arena);
+    else newNode = new Node(key, value);
 
     if (prev == nullptr) {
         // Inserting at the head if list is empty
@@ -80,7 +83,7 @@ Node* LinkedList::find(string key) {
 
     // Traverse the list to find the node
     while (current != nullptr) {
-        if (current->key == key) {
+        if (current->key.compare(key) == 0) {
             return current;
         }
         current = current->next;
@@ -90,6 +93,24 @@ Node* LinkedList::find(string key) {
     return nullptr;
 }
 
+// Unlink the node holding key; size is left to the caller, who knows what the node counted for
+bool LinkedList::remove(string key, bool release) {
+    Node* current = head;
+    Node* prev = nullptr;
+
+    while (current != nullptr) {
+        if (current->key.compare(key) == 0) {
+            if (prev == nullptr) head = current->next;
+            else prev->next = current->next;
+            if (release) delete current;
+            return true;
+        }
+        prev = current;
+        current = current->next;
+    }
+    return false;
+}
+
 // Clear the linked list by deleting all nodes
 void LinkedList::clear() {
     Node* current = head;
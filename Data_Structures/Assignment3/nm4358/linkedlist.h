@@ -10,25 +10,27 @@
 #define _LINKEDLIST_H
 #include<iostream>
 #include<string>
+#include<memory_resource>
 #include "maxheap.h"
 using std::string;
 //====================================
 class Node
 {
 	private:
-		string key;		// Stores the word 
+		std::pmr::string key;	// Stores the word (in the table's arena when it has one)
 		int value;		// Stores Hashcode of the word
 		Node* next; 
 		
 	public:
 		int freq = 1;
-		Node(string key, int value); 
+		Node(string key, int value, std::pmr::memory_resource* memory = std::pmr::get_default_resource()); 
 		string getKey();
 		int getValue();
 		void setKey(string key);
 		void setValue(int value);
 		friend class LinkedList;
 		friend class Heap;
+		friend class HashTable;
 };
 //=====================================
 class LinkedList
@@ -41,9 +43,10 @@ class LinkedList
 		~LinkedList (); // destructor to clean up all nodes
 		bool empty() const; // is  the list empty?
 		unsigned int getSize() const; //return number of elements in the linked list
-		void insert(string key, int value);	//Add a new key, pair value to the list, if the key already exist then update its value;
+		void insert(string key, int value, std::pmr::memory_resource* arena = nullptr);	//Add a new key, pair value to the list, if the key already exist then update its value; new nodes come from arena if given
 		Node* find(string key);	// Find a key and return the Node containing the key. return nullptr if the key is not found in the list
 		void clear();	//clear/remove all nodes of the linked list
+		bool remove(string key, bool release = true);	// unlink the node with this key, deleting it unless the arena owns it
 		friend class HashTable;
 		friend class Heap;
 };
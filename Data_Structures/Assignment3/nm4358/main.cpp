@@ -1,7 +1,9 @@
 
 #include<iostream>
+#include<iomanip>
 #include<sstream>
 #include <fstream>
+#include <chrono>
 #include "hashtable.h"
 #include "maxheap.h"
 using namespace std;
@@ -12,15 +14,39 @@ void listCommands()
 	cout<<"Welcome to the Word Count Wizard!"<<endl;
 	cout<<"List of available Commands:"<<endl;
 	cout<<"import <path>       :Import a TXT file"<<endl;
+	cout<<"import_pipeline <path> :Import a TXT file with reading, tokenizing and counting overlapped"<<endl;
+	cout<<"import_dir <dir|glob> :Import every file of a directory or glob in parallel"<<endl;
+	cout<<"reimport <dir|glob> :Keep the counts in step with a directory or glob, reading only changed files"<<endl;
 	cout<<"count_collisions    :Print the number of collisions"<<endl;
 	cout<<"count_unique_words  :Print the number of unique words"<<endl;
 	cout<<"count_words         :Print the the total number of words"<<endl;
-	cout<<"find_freq ‹word>    :Search for a word and return its frequency"<<endl;
+	cout<<"find_freq [--window] ‹word> :Search for a word and return its frequency"<<endl;
 	cout<<"find_max            :Print the word with the highest frequency"<<endl;
+	cout<<"top_k [--window] <k> :Print the k most frequent words"<<endl;
+	cout<<"window tokens|minutes <N> :Also count the words of the last N tokens/minutes (window off to stop)"<<endl;
+	cout<<"suggest <word> [k]  :Print the k most frequent words within edit distance 1-2 of a word"<<endl;
+	cout<<"context <k>|off     :Also count word pairs up to k tokens apart"<<endl;
+	cout<<"cooccur <word> [k]  :Print the k words that most often appear near a word"<<endl;
+	cout<<"export <path> [--by freq|alpha] :Write all words with their frequencies, sorted"<<endl;
+	cout<<"reset               :Forget all words before the next import"<<endl;
+	cout<<"memory arena|heap   :Allocate words from one reusable arena, or one by one (empties the table)"<<endl;
+	cout<<"hash <1-7>          :Choose the hash_code function (7 is keyed SipHash) and rehash"<<endl;
+	cout<<"hash_bench [words]  :Compare chain lengths and insert speed of functions 1 and 7 under a collision attack"<<endl;
+	cout<<"compact             :Store all words in a compact read-only dictionary until the next import"<<endl;
+	cout<<"spill <MB>|off      :Write sorted runs to disk whenever the table reaches MB, merged after each import"<<endl;
 	cout<<"exit                :Exit the program"<<endl;
 	cout<<"================================================="<<endl<<endl;
 }
 
+// Remove a leading option such as "--window" from a parameter, return true if it was there
+bool stripFlag(string &parameter, const string &flag)
+{
+	if (parameter.compare(0, flag.size(), flag) != 0) return false;
+	size_t start = parameter.find_first_not_of(' ', flag.size());
+	parameter = (start == string::npos) ? "" : parameter.substr(start);
+	return true;
+}
+
 int main()
 {
 	HashTable myHashTable(438259); // A prime number that is bigger than (306,578 + 30%)
@@ -50,14 +76,71 @@ int main()
 			
 			//add code as necessary
 			     if(command=="import") 			  		myHashTable.import(parameter); 
+			else if(command=="import_pipeline")			myHashTable.importPipelined(parameter);
+			else if(command=="import_dir")				myHashTable.importDir(parameter);
+			else if(command=="reimport")				myHashTable.reimport(parameter);
 			else if(command=="count_collisions")    	cout<<"The number of collisions is: "<<myHashTable.getCollisions()<<endl;
 			else if(command=="count_unique_words")    	cout<<"The number of unique words is: "<<myHashTable.getUniqueWords()<<endl;
 			else if(command=="count_words")    			cout<<"The total number words is: "<<myHashTable.getTotalWords()<<endl;
 			else if(command=="find_freq"){
+				bool windowed = stripFlag(parameter, "--window");
 				for (char &c : parameter){
 					c = tolower(c);
 				}
- 				cout<<"The frequency of the word \""<<parameter<<"\" is: "<<myHashTable.find_freq(parameter)<<endl;
+				if (windowed){
+					int freq = myHashTable.find_freq_window(parameter);
+					cout<<"The frequency of the word \""<<parameter<<"\" in the "<<myHashTable.describeWindow()<<" is: "<<freq<<endl;
+				}
+				else 		  cout<<"The frequency of the word \""<<parameter<<"\" is: "<<myHashTable.find_freq(parameter)<<endl;
+			}
+			else if(command=="top_k"){
+				bool windowed = stripFlag(parameter, "--window");
+				int k = parameter.empty() ? 10 : stoi(parameter);
+				vector<WordCount> words = windowed ? myHashTable.topK_window(k) : myHashTable.topK(k);
+				cout<<"The "<<words.size()<<" most frequent words ("<<(windowed ? myHashTable.describeWindow() : "all time")<<"):"<<endl;
+				for (size_t i = 0; i < words.size(); i++){
+					cout<<setw(4)<<i+1<<". "<<words[i].first<<" "<<words[i].second<<endl;
+				}
+			}
+			else if(command=="window")					myHashTable.setWindow(parameter);
+			else if(command=="suggest"){
+				stringstream args(parameter);
+				string word;
+				int k = 5;
+				args >> word >> k;
+				auto start = chrono::steady_clock::now();
+				vector<Suggestion> words = myHashTable.suggest(word, k);
+				double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+				cout<<"The "<<words.size()<<" suggestions for \""<<word<<"\" ("<<micros<<" us):"<<endl;
+				for (size_t i = 0; i < words.size(); i++){
+					cout<<setw(4)<<i+1<<". "<<words[i].word<<" "<<words[i].freq<<" (distance "<<words[i].distance<<")"<<endl;
+				}
+			}
+			else if(command=="context")					myHashTable.setContext(parameter);
+			else if(command=="cooccur"){
+				stringstream args(parameter);
+				string word;
+				int k = 10;
+				args >> word >> k;
+				vector<WordCount> words = myHashTable.cooccurring(word, k);
+				cout<<"The "<<words.size()<<" words most often near \""<<word<<"\":"<<endl;
+				for (size_t i = 0; i < words.size(); i++){
+					cout<<setw(4)<<i+1<<". "<<words[i].first<<" "<<words[i].second<<endl;
+				}
+			}
+			else if(command=="reset")					myHashTable.reset();
+			else if(command=="memory")					myHashTable.setMemoryMode(parameter);
+			else if(command=="compact")					myHashTable.compact();
+			else if(command=="spill")					myHashTable.setSpill(parameter);
+			else if(command=="hash")					myHashTable.setHashFunction(stoi(parameter));
+			else if(command=="hash_bench")				myHashTable.benchmarkHashing(parameter.empty() ? 20000 : stoi(parameter));
+			else if(command=="export"){
+				stringstream args(parameter);
+				string path, option, order = "freq";
+				args >> path >> option;
+				if (option == "--by") args >> order;
+				else if (!option.empty()) order = "";
+				myHashTable.exportData(path, order);
 			}
 			else if(command=="find_max") 				cout<<"The word with the heighest frequency is: "<<myHashTable.findMax()<<endl;
 			else if(command == "help")					listCommands();
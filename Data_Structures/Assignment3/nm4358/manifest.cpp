@@ -0,0 +1,80 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Per-file fingerprints and word contributions for incremental re-import
+//============================================================================
+#include "manifest.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+using namespace std;
+
+bool Manifest::stat(const string& path, uint64_t& size, int64_t& mtime)
+{
+	error_code ec;
+	size = filesystem::file_size(path, ec);
+	if (ec) return false;
+	mtime = filesystem::last_write_time(path, ec).time_since_epoch().count();
+	return !ec;
+}
+
+// FNV-1a taken eight bytes at a time: the file is read once at disk speed, and a
+// changed byte anywhere changes the result
+uint64_t Manifest::hashFile(const string& path)
+{
+	const uint64_t PRIME = 0x100000001b3ULL;
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == nullptr) return 0;
+	vector<char> buffer(1 << 20);
+	size_t got;
+	while ((got = fread(buffer.data(), 1, buffer.size(), file)) > 0)
+	{
+		size_t i = 0;
+		for (; i + 8 <= got; i += 8)
+		{
+			uint64_t word;
+			memcpy(&word, buffer.data() + i, 8);
+			hash = (hash ^ word) * PRIME;
+		}
+		for (; i < got; i++) hash = (hash ^ (unsigned char)buffer[i]) * PRIME;
+	}
+	fclose(file);
+	return hash;
+}
+
+FileRecord* Manifest::find(const string& path)
+{
+	auto it = files.find(path);
+	return it == files.end() ? nullptr : &it->second;
+}
+
+void Manifest::update(const string& path, FileRecord record)
+{
+	files[path] = std::move(record);
+}
+
+void Manifest::erase(const string& path)
+{
+	files.erase(path);
+}
+
+vector<string> Manifest::paths() const
+{
+	vector<string> all;
+	all.reserve(files.size());
+	for (const auto& entry : files) all.push_back(entry.first);
+	return all;
+}
+
+size_t Manifest::size() const
+{
+	return files.size();
+}
+
+void Manifest::clear()
+{
+	files.clear();
+}
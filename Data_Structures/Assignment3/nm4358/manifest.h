@@ -0,0 +1,47 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Per-file fingerprints and word contributions for incremental re-import
+//============================================================================
+
+#ifndef _MANIFEST_H
+#define _MANIFEST_H
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "topk.h"
+using std::string;
+using std::vector;
+
+// What one file added to the table, and how to tell whether it changed since
+struct FileRecord
+{
+	uint64_t size;
+	int64_t mtime;				// modification time in the filesystem clock's ticks
+	uint64_t hash;				// content hash, only computed when size or mtime moved
+	vector<WordCount> counts;	// the file's own word frequencies
+};
+
+// Re-importing a collection compares every file against its record: files whose size and
+// mtime are unchanged are skipped without being read, files whose bytes hash the same
+// only get their mtime updated, and everything else has its old contribution subtracted
+// from the table before the new one is added.
+class Manifest
+{
+	private:
+		std::unordered_map<string, FileRecord> files;
+
+	public:
+		static bool stat(const string& path, uint64_t& size, int64_t& mtime);	// false if the file is gone
+		static uint64_t hashFile(const string& path);
+		FileRecord* find(const string& path);		// nullptr for files never imported
+		void update(const string& path, FileRecord record);
+		void erase(const string& path);
+		vector<string> paths() const;
+		size_t size() const;
+		void clear();
+};
+#endif
@@ -61,7 +61,7 @@ void Heap::print()
 }
 
 //Constructor
-Heap::Heap()
+Heap::Heap(std::pmr::memory_resource* memory) : array(memory)
 {
 	array.push_back(0); //add a dummy value to the first location of the array that will remain unused
 }
@@ -135,12 +135,11 @@ void Heap::bubbledown(int k)
 	int biggest = k;
 	int leftChild = left(k);
 	int rightChild = right(k);
-    int biggest_size = array[biggest]->getSize();
 
-	if (leftChild < array.size() && array[leftChild]->getSize() > biggest_size) {
+	if (leftChild < array.size() && array[leftChild]->getSize() > array[biggest]->getSize()) {
 		biggest = leftChild;
 	}
-	if (rightChild < array.size() && array[rightChild]->getSize() > biggest_size) {
+	if (rightChild < array.size() && array[rightChild]->getSize() > array[biggest]->getSize()) {
 		biggest = rightChild;
 	}
 	if (biggest != k) {
@@ -149,6 +148,13 @@ void Heap::bubbledown(int k)
 		bubbledown(biggest);
 	}
 }
+// Bottom-up heap construction: bubble down every internal node, last one first
+void Heap::heapify()
+{
+	for (int k = (array.size() - 1) / 2; k >= 1; k--) {
+		bubbledown(k);
+	}
+}
 //=====================================
 // This method will sort the internal array/vector 
 // Hints: 
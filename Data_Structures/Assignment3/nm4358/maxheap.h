@@ -9,6 +9,7 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <memory_resource>
 
 //#include "linkedlist.h" // Ensure linkedlist.h is included properly
 
@@ -24,9 +25,9 @@ class LinkedList;
 class Heap
 {
 	private:
-		vector<LinkedList*> array;
+		std::pmr::vector<LinkedList*> array;	// storage comes from the table's arena in arena mode
 	public:
-		Heap();
+		Heap(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 		void insert(LinkedList* key);
 		LinkedList* removeMax();
 		string getMax();
@@ -35,6 +36,7 @@ class Heap
 		int right(int k);
 		void bubbleup(int k);
 		void bubbledown(int k);
+		void heapify();		// restore the heap property after priorities changed in bulk
 		void print();
 		void sort();
 };
@@ -0,0 +1,144 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Three-stage (read -> tokenize -> count) pipelined import
+//============================================================================
+#include "pipeline.h"
+#include "hashtable.h"
+#include "tokenizer.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+using namespace std;
+
+ImportPipeline::ImportPipeline(HashTable& table) : table(table), blocks(8), batches(64)
+{
+	reader.name = "reader";
+	reader.unit = "MB";
+	tokenizer.name = "tokenizer";
+	tokenizer.unit = "MB";
+	counter.name = "counter";
+	counter.unit = "words";
+}
+
+// Stage 1: fill large buffers from disk, decompressing on this thread when the
+// input is compressed. Every block ends on whitespace so the tokenizer never
+// sees half a word; the tail is carried into the next block.
+void ImportPipeline::readStage(InputStream* input)
+{
+	auto start = chrono::steady_clock::now();
+	string carry;
+	while (true)
+	{
+		string block = std::move(carry);
+		size_t kept = block.size();
+		block.resize(kept + BLOCK_SIZE);
+		size_t got = input->read(&block[kept], BLOCK_SIZE);
+		block.resize(kept + got);
+		reader.volume += got;
+		if (got == 0)
+		{
+			if (!block.empty()) blocks.push(block, reader.waited);
+			break;
+		}
+		size_t cut = block.size();
+		while (cut > 0 && !Tokenizer::isSpace(block[cut - 1])) cut--;
+		if (cut == 0)
+		{
+			carry = std::move(block);		// no whitespace yet: keep growing this word
+			continue;
+		}
+		carry.assign(block, cut, string::npos);
+		block.resize(cut);
+		blocks.push(block, reader.waited);
+	}
+	blocks.close();
+	reader.elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Stage 2: split and normalize blocks into batches of words
+void ImportPipeline::tokenizeStage()
+{
+	auto start = chrono::steady_clock::now();
+	string block;
+	vector<string> batch;
+	batch.reserve(BATCH_SIZE);
+	while (blocks.pop(block, tokenizer.waited))
+	{
+		tokenizer.volume += block.size();
+		Tokenizer::forEachWord(block.data(), block.data() + block.size(), [&](const string& word) {
+			batch.push_back(word);
+			if (batch.size() == BATCH_SIZE)
+			{
+				batches.push(batch, tokenizer.waited);
+				batch.clear();
+				batch.reserve(BATCH_SIZE);
+			}
+		});
+	}
+	if (!batch.empty()) batches.push(batch, tokenizer.waited);
+	batches.close();
+	tokenizer.elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Stage 3: insert every word into the hash table
+void ImportPipeline::countStage()
+{
+	auto start = chrono::steady_clock::now();
+	vector<string> batch;
+	while (batches.pop(batch, counter.waited))
+	{
+		for (const string& word : batch)
+		{
+			table.insert(word);
+		}
+		counter.volume += batch.size();
+	}
+	counter.elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+bool ImportPipeline::run(string path)
+{
+	InputStream::Format format = InputStream::detect(path);
+	InputStream* input = InputStream::open(path);
+	if (input == nullptr) return false;
+	if (format != InputStream::PLAIN)
+	{
+		reader.name = InputStream::formatName(format);
+		cout << "Decompressing " << reader.name << " input while counting..." << endl;
+	}
+	// The reader and tokenizer get their own threads; the calling thread is the counter
+	thread readThread(&ImportPipeline::readStage, this, input);
+	thread tokenizeThread(&ImportPipeline::tokenizeStage, this);
+	countStage();
+	readThread.join();
+	tokenizeThread.join();
+	bool ok = !input->failed();
+	delete input;
+	if (!ok) cout << "Input is corrupt, counts include only the data decoded before the error: " + path << endl;
+	return ok;
+}
+
+void ImportPipeline::printStats()
+{
+	Stage* stages[] = { &reader, &tokenizer, &counter };
+	Stage* bottleneck = stages[0];
+	cout << "Pipeline stages:" << endl;
+	for (Stage* s : stages)
+	{
+		double busy = s->elapsed - s->waited;
+		double volume = (s->unit == "MB") ? s->volume / double(1 << 20) : double(s->volume);
+		int digits = (s->unit == "MB") ? 1 : 0;
+		cout << "  " << left << setw(10) << s->name << right << fixed << setprecision(digits)
+			 << setw(12) << volume << " " << left << setw(6) << s->unit << right
+			 << " busy " << setprecision(3) << busy << "s, blocked " << s->waited << "s, "
+			 << setprecision(digits) << (busy > 0 ? volume / busy : 0) << " " << s->unit << "/s" << endl;
+		if (busy > bottleneck->elapsed - bottleneck->waited) bottleneck = s;
+	}
+	cout << "Bottleneck: " << bottleneck->name << endl;
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
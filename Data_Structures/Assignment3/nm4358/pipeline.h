@@ -0,0 +1,47 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Three-stage (read -> tokenize -> count) pipelined import
+//============================================================================
+
+#ifndef _PIPELINE_H
+#define _PIPELINE_H
+#include <string>
+#include <vector>
+#include "spscqueue.h"
+#include "inputstream.h"
+using std::string;
+using std::vector;
+
+class HashTable;
+
+class ImportPipeline
+{
+	private:
+		struct Stage
+		{
+			string name;
+			string unit;						// what volume counts: "MB" or "words"
+			double elapsed = 0;					// wall time of the stage
+			double waited = 0;					// time blocked on an empty input or full output queue
+			unsigned long long volume = 0;
+		};
+		HashTable& table;
+		SPSCQueue<string> blocks;				// reader -> tokenizer: raw text ending on whitespace
+		SPSCQueue<vector<string>> batches;		// tokenizer -> counter: normalized words
+		Stage reader, tokenizer, counter;
+
+		void readStage(InputStream* input);
+		void tokenizeStage();
+		void countStage();
+
+	public:
+		static constexpr size_t BLOCK_SIZE = 1 << 20;	// bytes per read
+		static constexpr size_t BATCH_SIZE = 4096;		// words per batch
+		ImportPipeline(HashTable& table);
+		bool run(string path);					// false if the file cannot be opened or decoded
+		void printStats();						// per-stage throughput and blocked time
+};
+#endif
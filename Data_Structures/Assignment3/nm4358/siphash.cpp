@@ -0,0 +1,50 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : SipHash-1-3 keyed hash for the collision-resistant hash_code mode
+//============================================================================
+#include "siphash.h"
+#include <cstring>
+
+static inline uint64_t rotl(uint64_t x, int b)
+{
+	return (x << b) | (x >> (64 - b));
+}
+
+static inline void sipround(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3)
+{
+	v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+	v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+	v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+	v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+}
+
+uint64_t siphash13(const char* data, size_t length, uint64_t k0, uint64_t k1)
+{
+	uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+	uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+	uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+	uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+	const char* end = data + (length & ~(size_t)7);
+	for (; data != end; data += 8)
+	{
+		uint64_t m;
+		memcpy(&m, data, 8);	// little-endian hosts, as the reference implementation assumes
+		v3 ^= m;
+		sipround(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+	// Last block: the remaining bytes plus the length in the top byte
+	uint64_t b = (uint64_t)length << 56;
+	for (size_t i = 0; i < (length & 7); i++) b |= (uint64_t)(unsigned char)data[i] << (8 * i);
+	v3 ^= b;
+	sipround(v0, v1, v2, v3);
+	v0 ^= b;
+
+	v2 ^= 0xff;
+	for (int i = 0; i < 3; i++) sipround(v0, v1, v2, v3);
+	return v0 ^ v1 ^ v2 ^ v3;
+}
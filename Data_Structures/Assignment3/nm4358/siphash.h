@@ -0,0 +1,18 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : SipHash-1-3 keyed hash for the collision-resistant hash_code mode
+//============================================================================
+
+#ifndef _SIPHASH_H
+#define _SIPHASH_H
+#include <cstddef>
+#include <cstdint>
+
+// SipHash with one compression and three finalization rounds (the variant Python and
+// Rust use for their hash tables). Without the 128-bit key an attacker cannot predict
+// which bucket a word lands in, so crafted inputs cannot pile words into one chain.
+uint64_t siphash13(const char* data, size_t length, uint64_t k0, uint64_t k1);
+#endif
@@ -0,0 +1,161 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Parallel sorts and buffered output for exporting word counts
+//============================================================================
+#include "sorting.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+using namespace std;
+
+void radixSortByFreq(vector<WordEntry>& entries, ThreadPool& pool)
+{
+	size_t n = entries.size();
+	if (n < 2) return;
+	unsigned int threads = pool.size();
+	size_t slice = (n + threads - 1) / threads;
+	unsigned int used_bits = 0;
+	for (const WordEntry& e : entries) used_bits |= e.freq;
+
+	vector<WordEntry> scratch(n);
+	vector<array<size_t, 256>> counts(threads);
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		if (((used_bits >> shift) & 0xFF) == 0) continue;
+		// Histogram of this byte per slice; 255 - byte puts the largest frequencies first
+		for (unsigned int t = 0; t < threads; t++)
+		{
+			pool.submit([&, t, shift](int) {
+				counts[t].fill(0);
+				size_t end = min(n, (t + 1) * slice);
+				for (size_t i = t * slice; i < end; i++) counts[t][255 - ((entries[i].freq >> shift) & 0xFF)]++;
+			});
+		}
+		pool.wait();
+		// Digit-major, slice-minor offsets keep equal keys in their original order (stable)
+		size_t offset = 0;
+		for (int d = 0; d < 256; d++)
+		{
+			for (unsigned int t = 0; t < threads; t++)
+			{
+				size_t count = counts[t][d];
+				counts[t][d] = offset;
+				offset += count;
+			}
+		}
+		for (unsigned int t = 0; t < threads; t++)
+		{
+			pool.submit([&, t, shift](int) {
+				size_t end = min(n, (t + 1) * slice);
+				for (size_t i = t * slice; i < end; i++)
+				{
+					scratch[counts[t][255 - ((entries[i].freq >> shift) & 0xFF)]++] = entries[i];
+				}
+			});
+		}
+		pool.wait();
+		entries.swap(scratch);
+	}
+}
+
+void sortAlphabetically(vector<WordEntry>& entries, ThreadPool& pool)
+{
+	auto before = [](const WordEntry& a, const WordEntry& b) { return a.word < b.word; };
+	unsigned int threads = pool.size();
+	vector<size_t> bounds;
+	for (unsigned int t = 0; t <= threads; t++) bounds.push_back(entries.size() * t / threads);
+
+	for (unsigned int t = 0; t < threads; t++)
+	{
+		pool.submit([&, t](int) {
+			sort(entries.begin() + bounds[t], entries.begin() + bounds[t + 1], before);
+		});
+	}
+	pool.wait();
+	// Merge neighbouring sorted runs, doubling the run width every round
+	for (unsigned int width = 1; width < threads; width *= 2)
+	{
+		for (unsigned int t = 0; t + width < threads; t += 2 * width)
+		{
+			pool.submit([&, t, width](int) {
+				inplace_merge(entries.begin() + bounds[t], entries.begin() + bounds[t + width],
+							  entries.begin() + bounds[min(threads, t + 2 * width)], before);
+			});
+		}
+		pool.wait();
+	}
+}
+
+//====================================
+BufferedWriter::BufferedWriter(const string& path, size_t capacity) : file(fopen(path.c_str(), "wb")), buffer(capacity), used(0), flushed(0) {}
+
+BufferedWriter::~BufferedWriter()
+{
+	close();
+}
+
+bool BufferedWriter::isOpen() const
+{
+	return file != nullptr;
+}
+
+void BufferedWriter::flush()
+{
+	if (used > 0 && file != nullptr) fwrite(buffer.data(), 1, used, file);
+	flushed += used;
+	used = 0;
+}
+
+void BufferedWriter::write(const char* data, size_t size)
+{
+	if (used + size > buffer.size())
+	{
+		flush();
+		if (size > buffer.size())
+		{
+			if (file != nullptr) fwrite(data, 1, size, file);
+			flushed += size;
+			return;
+		}
+	}
+	memcpy(buffer.data() + used, data, size);
+	used += size;
+}
+
+void BufferedWriter::write(std::string_view text)
+{
+	write(text.data(), text.size());
+}
+
+void BufferedWriter::write(char c)
+{
+	if (used == buffer.size()) flush();
+	buffer[used++] = c;
+}
+
+void BufferedWriter::write(unsigned long value)
+{
+	char digits[24];
+	char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+	write(digits, end - digits);
+}
+
+uint64_t BufferedWriter::position() const
+{
+	return flushed + used;
+}
+
+bool BufferedWriter::close()
+{
+	if (file == nullptr) return false;
+	flush();
+	bool ok = !ferror(file);
+	ok = (fclose(file) == 0) && ok;
+	file = nullptr;
+	return ok;
+}
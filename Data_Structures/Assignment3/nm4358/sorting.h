@@ -0,0 +1,56 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Parallel sorts and buffered output for exporting word counts
+//============================================================================
+
+#ifndef _SORTING_H
+#define _SORTING_H
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+using std::string;
+using std::vector;
+
+class ThreadPool;
+
+struct WordEntry
+{
+	std::string_view word;		// views the key stored in the table, never copied
+	unsigned int freq;
+};
+
+// Stable LSD radix sort on freq, highest first. Each 8-bit pass builds per-thread
+// histograms, prefix-sums them into per-thread scatter offsets and scatters in parallel.
+// Passes over bytes that are zero in every key are skipped.
+void radixSortByFreq(vector<WordEntry>& entries, ThreadPool& pool);
+
+// Alphabetical order: every thread sorts a slice, then slices are merged pairwise in parallel
+void sortAlphabetically(vector<WordEntry>& entries, ThreadPool& pool);
+
+// Collects output in a large buffer and hands it to the OS in big writes
+class BufferedWriter
+{
+	private:
+		FILE* file;
+		vector<char> buffer;
+		size_t used;
+		uint64_t flushed;			// bytes already handed to the OS
+		void flush();
+
+	public:
+		BufferedWriter(const string& path, size_t capacity = 4 << 20);
+		~BufferedWriter();
+		bool isOpen() const;
+		void write(const char* data, size_t size);
+		void write(std::string_view text);
+		void write(char c);
+		void write(unsigned long value);
+		uint64_t position() const;	// bytes written so far, buffered or not
+		bool close();				// flush and close, false if anything failed to write
+};
+#endif
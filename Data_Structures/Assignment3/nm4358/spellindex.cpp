@@ -0,0 +1,103 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Symmetric-delete index for spelling suggestions within edit distance 2
+//============================================================================
+#include "spellindex.h"
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+using namespace std;
+
+// Visit the hash of the word's prefix and of every string made by deleting up to
+// MAX_DISTANCE of its characters. Repeated letters give repeated deletes; callers cope.
+template <typename Visit>
+void SpellIndex::forEachDelete(const string& word, Visit visit)
+{
+	string prefix = word.substr(0, PREFIX);
+	hash<string_view> hasher;
+	visit(hasher(prefix));
+	string one, two;
+	for (size_t i = 0; i < prefix.size(); i++)
+	{
+		one = prefix;
+		one.erase(i, 1);
+		visit(hasher(one));
+		// Deleting j >= i from the shorter string covers every pair of positions once
+		for (size_t j = i; j < one.size(); j++)
+		{
+			two = one;
+			two.erase(j, 1);
+			visit(hasher(two));
+		}
+	}
+}
+
+// Optimal string alignment: Levenshtein plus swaps of neighbouring characters. Keeps
+// only the last three rows, and stops once a whole row is past MAX_DISTANCE.
+unsigned int SpellIndex::distance(string_view a, string_view b)
+{
+	vector<unsigned int> before(b.size() + 1), previous(b.size() + 1), row(b.size() + 1);
+	for (size_t j = 0; j <= b.size(); j++) previous[j] = j;
+	for (size_t i = 1; i <= a.size(); i++)
+	{
+		row[0] = i;
+		unsigned int best = row[0];
+		for (size_t j = 1; j <= b.size(); j++)
+		{
+			unsigned int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+			row[j] = min({ previous[j] + 1, row[j - 1] + 1, previous[j - 1] + cost });
+			if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) row[j] = min(row[j], before[j - 2] + 1);
+			best = min(best, row[j]);
+		}
+		if (best > MAX_DISTANCE) return best;
+		before.swap(previous);
+		previous.swap(row);
+	}
+	return previous[b.size()];
+}
+
+void SpellIndex::add(const string& word)
+{
+	uint32_t id = words.size();
+	words.push_back(word);
+	forEachDelete(word, [this, id](uint64_t key) {
+		vector<uint32_t>& ids = deletes[key];
+		if (ids.empty() || ids.back() != id) ids.push_back(id);
+	});
+}
+
+vector<pair<string, unsigned int>> SpellIndex::near(const string& word)
+{
+	vector<pair<string, unsigned int>> found;
+	unordered_set<uint32_t> seen;
+	forEachDelete(word, [&](uint64_t key) {
+		auto it = deletes.find(key);
+		if (it == deletes.end()) return;
+		for (uint32_t id : it->second)
+		{
+			if (!seen.insert(id).second) continue;
+			const string& candidate = words[id];
+			// Lengths further apart than the distance bound cannot qualify
+			size_t gap = candidate.size() > word.size() ? candidate.size() - word.size() : word.size() - candidate.size();
+			if (gap > MAX_DISTANCE) continue;
+			unsigned int d = distance(word, candidate);
+			if (d <= MAX_DISTANCE) found.emplace_back(candidate, d);
+		}
+	});
+	return found;
+}
+
+size_t SpellIndex::size() const
+{
+	return words.size();
+}
+
+size_t SpellIndex::entries() const
+{
+	size_t total = 0;
+	for (const auto& entry : deletes) total += entry.second.size();
+	return total;
+}
@@ -0,0 +1,53 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Symmetric-delete index for spelling suggestions within edit distance 2
+//============================================================================
+
+#ifndef _SPELLINDEX_H
+#define _SPELLINDEX_H
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using std::string;
+using std::vector;
+
+struct Suggestion
+{
+	string word;
+	unsigned int freq;
+	unsigned int distance;
+};
+
+// SymSpell: every vocabulary word is filed under each string obtained by deleting up to
+// MAX_DISTANCE characters from it. A query generates its own deletes and looks them up;
+// two words within edit distance d always share a delete of at most d characters each, so
+// the lookups find every candidate without scanning the vocabulary. Candidates are then
+// checked with the real (optimal string alignment) distance.
+// Only the first PREFIX characters are used for deletes, which bounds the index at 29
+// entries per word; the check still uses whole words.
+class SpellIndex
+{
+	private:
+		static constexpr unsigned int MAX_DISTANCE = 2;
+		static constexpr unsigned int PREFIX = 7;
+		std::deque<string> words;					// id -> word
+		std::unordered_map<uint64_t, vector<uint32_t>> deletes;	// hash of a delete -> ids of words that have it
+
+		template <typename Visit>
+		static void forEachDelete(const string& word, Visit visit);
+		static unsigned int distance(std::string_view a, std::string_view b);
+
+	public:
+		void add(const string& word);
+		vector<std::pair<string, unsigned int>> near(const string& word);	// words within MAX_DISTANCE, with their distance
+		size_t size() const;
+		size_t entries() const;						// delete entries, for memory estimates
+};
+#endif
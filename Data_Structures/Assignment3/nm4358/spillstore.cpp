@@ -0,0 +1,238 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : On-disk sorted runs and merged dictionary for out-of-core counting
+//============================================================================
+#include "spillstore.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+#include <stdlib.h>
+using namespace std;
+
+// Record layout in run and dictionary files: uint32 length, the word's bytes, uint64 count
+static void writeRecord(BufferedWriter& out, string_view word, uint64_t count)
+{
+	uint32_t length = word.size();
+	out.write((const char*)&length, sizeof(length));
+	out.write(word);
+	out.write((const char*)&count, sizeof(count));
+}
+
+// Sequential reader over one run or dictionary file
+class RunReader
+{
+	private:
+		FILE* file;
+		vector<char> buffer;
+	public:
+		string word;
+		uint64_t count;
+		RunReader(const string& path, size_t buffer_size) : file(fopen(path.c_str(), "rb")), buffer(buffer_size), count(0)
+		{
+			if (file == nullptr) throw runtime_error("Unable to open spill file: " + path);
+			setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+		}
+		~RunReader()
+		{
+			fclose(file);
+		}
+		void seek(uint64_t offset)
+		{
+			fseeko(file, offset, SEEK_SET);
+		}
+		bool next()
+		{
+			uint32_t length;
+			if (fread(&length, sizeof(length), 1, file) != 1) return false;
+			word.resize(length);
+			if (length > 0 && fread(&word[0], 1, length, file) != length) return false;
+			return fread(&count, sizeof(count), 1, file) == 1;
+		}
+};
+
+SpillStore::SpillStore(size_t budget) : budget(budget), files(0), step(64), unique(0), total(0), max_freq(0)
+{
+	string pattern = (filesystem::temp_directory_path() / "wordcount-XXXXXX").string();
+	if (mkdtemp(&pattern[0]) == nullptr) throw runtime_error("Unable to create a temporary directory for spill files");
+	directory = pattern;
+}
+
+SpillStore::~SpillStore()
+{
+	error_code ec;
+	filesystem::remove_all(directory, ec);
+}
+
+string SpillStore::newFile(const string& kind)
+{
+	return directory + "/" + kind + "-" + to_string(files++);
+}
+
+size_t SpillStore::getBudget() const
+{
+	return budget;
+}
+
+void SpillStore::writeRun(const vector<WordEntry>& entries)
+{
+	string path = newFile("run");
+	BufferedWriter out(path, min<size_t>(4 << 20, budget / 8));
+	if (!out.isOpen()) throw runtime_error("Unable to create spill file: " + path);
+	for (const WordEntry& e : entries)
+	{
+		writeRecord(out, e.word, e.freq);
+	}
+	if (!out.close()) throw runtime_error("Unable to write spill file (disk full?): " + path);
+	runs.push_back(path);
+}
+
+bool SpillStore::hasRuns() const
+{
+	return !runs.empty();
+}
+
+bool SpillStore::isMerged() const
+{
+	return !merged.empty();
+}
+
+void SpillStore::merge()
+{
+	vector<string> inputs = runs;
+	if (!merged.empty()) inputs.push_back(merged);
+	if (inputs.empty()) return;
+
+	// Half the budget goes to read buffers, shared by all inputs
+	size_t buffer_size = max<size_t>(4096, min<size_t>(1 << 20, budget / 2 / inputs.size()));
+	vector<RunReader*> readers;
+	for (const string& path : inputs)
+	{
+		RunReader* reader = new RunReader(path, buffer_size);
+		if (reader->next()) readers.push_back(reader);
+		else delete reader;
+	}
+	// Min-heap of readers ordered by their current word
+	auto later = [&readers](size_t a, size_t b) { return readers[a]->word > readers[b]->word; };
+	priority_queue<size_t, vector<size_t>, decltype(later)> heads(later);
+	for (size_t i = 0; i < readers.size(); i++) heads.push(i);
+
+	string output = newFile("merged");
+	BufferedWriter out(output, min<size_t>(4 << 20, budget / 8));
+	if (!out.isOpen()) throw runtime_error("Unable to create spill file: " + output);
+	index.clear();
+	step = 64;
+	size_t index_bytes = 0;
+	unique = total = max_freq = 0;
+	max_word.clear();
+
+	string word;
+	uint64_t sum = 0;
+	auto emit = [&]() {
+		if (unique % step == 0)
+		{
+			index.emplace_back(word, out.position());
+			index_bytes += sizeof(index[0]) + word.size();
+			// Keep the index within a quarter of the budget by keeping every other entry
+			if (index_bytes > budget / 4)
+			{
+				vector<pair<string, uint64_t>> thinned;
+				index_bytes = 0;
+				for (size_t i = 0; i < index.size(); i += 2)
+				{
+					index_bytes += sizeof(index[0]) + index[i].first.size();
+					thinned.push_back(std::move(index[i]));
+				}
+				index.swap(thinned);
+				step *= 2;
+			}
+		}
+		writeRecord(out, word, sum);
+		unique++;
+		total += sum;
+		if (sum > max_freq)
+		{
+			max_freq = sum;
+			max_word = word;
+		}
+	};
+	bool started = false;
+	while (!heads.empty())
+	{
+		size_t i = heads.top();
+		heads.pop();
+		RunReader* reader = readers[i];
+		if (started && reader->word == word) sum += reader->count;
+		else
+		{
+			if (started) emit();
+			word = reader->word;
+			sum = reader->count;
+			started = true;
+		}
+		if (reader->next()) heads.push(i);
+	}
+	if (started) emit();
+	for (RunReader* reader : readers) delete reader;
+	if (!out.close()) throw runtime_error("Unable to write spill file (disk full?): " + output);
+
+	for (const string& path : inputs) remove(path.c_str());
+	runs.clear();
+	merged = output;
+}
+
+uint64_t SpillStore::find_freq(const string& word)
+{
+	// Last indexed word <= word, then scan at most one step of records
+	auto it = upper_bound(index.begin(), index.end(), word,
+						  [](const string& w, const pair<string, uint64_t>& entry) { return w < entry.first; });
+	if (it == index.begin()) return 0;
+	--it;
+	RunReader reader(merged, 16 << 10);
+	reader.seek(it->second);
+	for (unsigned int i = 0; i < step && reader.next(); i++)
+	{
+		if (reader.word == word) return reader.count;
+		if (reader.word > word) break;
+	}
+	return 0;
+}
+
+string SpillStore::findMax() const
+{
+	if (unique == 0) throw out_of_range("Heap is empty.");
+	return max_word;
+}
+
+uint64_t SpillStore::getUniqueWords() const
+{
+	return unique;
+}
+
+uint64_t SpillStore::getTotalWords() const
+{
+	return total;
+}
+
+void SpillStore::forEach(const function<void(const string&, uint64_t)>& visit)
+{
+	if (merged.empty()) return;
+	RunReader reader(merged, 1 << 20);
+	while (reader.next()) visit(reader.word, reader.count);
+}
+
+void SpillStore::clear()
+{
+	for (const string& path : runs) remove(path.c_str());
+	if (!merged.empty()) remove(merged.c_str());
+	runs.clear();
+	merged.clear();
+	index.clear();
+	unique = total = max_freq = 0;
+	max_word.clear();
+}
@@ -0,0 +1,54 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : On-disk sorted runs and merged dictionary for out-of-core counting
+//============================================================================
+
+#ifndef _SPILLSTORE_H
+#define _SPILLSTORE_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sorting.h"
+using std::string;
+using std::vector;
+
+// When the table outgrows the memory budget its words are written, sorted, to a run
+// file and the table starts empty again. merge() combines all runs (and the result
+// of any earlier merge) with a k-way merge into one sorted dictionary file. Queries
+// are answered from that file through a sparse in-memory index of every step-th word.
+class SpillStore
+{
+	private:
+		size_t budget;						// bytes the counting working set may use
+		string directory;					// private temp directory for run files
+		vector<string> runs;				// sorted runs not merged yet
+		string merged;						// merged dictionary, empty until the first merge
+		unsigned int files;					// used to name new files
+		vector<std::pair<string, uint64_t>> index;	// (word, file offset) of every step-th record
+		unsigned int step;
+		uint64_t unique, total, max_freq;
+		string max_word;
+
+		string newFile(const string& kind);
+
+	public:
+		SpillStore(size_t budget);
+		~SpillStore();						// removes every file it created
+		size_t getBudget() const;
+		void writeRun(const vector<WordEntry>& entries);	// entries in alphabetical order
+		bool hasRuns() const;
+		bool isMerged() const;
+		void merge();						// fold all runs into the merged dictionary
+		uint64_t find_freq(const string& word);
+		string findMax() const;				// most frequent word, alphabetically first on ties
+		uint64_t getUniqueWords() const;
+		uint64_t getTotalWords() const;
+		void forEach(const std::function<void(const string&, uint64_t)>& visit);	// alphabetical order
+		void clear();						// delete every run and the merged dictionary
+};
+#endif
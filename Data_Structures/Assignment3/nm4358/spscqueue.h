@@ -0,0 +1,99 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Bounded lock-free single-producer/single-consumer ring buffer
+//============================================================================
+
+#ifndef _SPSCQUEUE_H
+#define _SPSCQUEUE_H
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+using std::vector;
+
+template <typename T>
+class SPSCQueue
+{
+	private:
+		vector<T> slots;
+		size_t mask;							// capacity - 1, capacity is a power of two
+		alignas(64) std::atomic<size_t> head;	// next slot to pop, written by the consumer only
+		alignas(64) std::atomic<size_t> tail;	// next slot to push, written by the producer only
+		std::atomic<bool> closed;				// producer is done
+
+	public:
+		SPSCQueue(size_t capacity);
+		bool tryPush(T& item);					// moves item in, false if the queue is full
+		bool tryPop(T& item);					// false if the queue is empty
+		void push(T& item, double& waited);		// block while full, adding the blocked seconds to waited
+		bool pop(T& item, double& waited);		// block while empty, false once closed and drained
+		void close();
+};
+//========================================
+template <typename T>
+SPSCQueue<T>::SPSCQueue(size_t capacity) : head(0), tail(0), closed(false)
+{
+	size_t size = 2;
+	while (size < capacity) size <<= 1;
+	slots.resize(size);
+	mask = size - 1;
+}
+//========================================
+template <typename T>
+bool SPSCQueue<T>::tryPush(T& item)
+{
+	size_t t = tail.load(std::memory_order_relaxed);
+	if (t - head.load(std::memory_order_acquire) > mask) return false;
+	slots[t & mask] = std::move(item);
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+//========================================
+template <typename T>
+bool SPSCQueue<T>::tryPop(T& item)
+{
+	size_t h = head.load(std::memory_order_relaxed);
+	if (h == tail.load(std::memory_order_acquire)) return false;
+	item = std::move(slots[h & mask]);
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+//========================================
+template <typename T>
+void SPSCQueue<T>::push(T& item, double& waited)
+{
+	if (tryPush(item)) return;
+	auto start = std::chrono::steady_clock::now();
+	while (!tryPush(item)) std::this_thread::yield();
+	waited += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+//========================================
+template <typename T>
+bool SPSCQueue<T>::pop(T& item, double& waited)
+{
+	if (tryPop(item)) return true;
+	auto start = std::chrono::steady_clock::now();
+	bool got = false;
+	while (!(got = tryPop(item)))
+	{
+		// Re-check after seeing closed: the last push may land just before close()
+		if (closed.load(std::memory_order_acquire))
+		{
+			got = tryPop(item);
+			break;
+		}
+		std::this_thread::yield();
+	}
+	waited += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return got;
+}
+//========================================
+template <typename T>
+void SPSCQueue<T>::close()
+{
+	closed.store(true, std::memory_order_release);
+}
+#endif
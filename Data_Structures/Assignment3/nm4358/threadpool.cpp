@@ -0,0 +1,150 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Work-stealing thread pool used by the multi-file import
+//============================================================================
+#include "threadpool.h"
+#include <iostream>
+#include <iomanip>
+using namespace std;
+
+// Which pool/worker the calling thread belongs to (nullptr/-1 for outside threads)
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local int current_worker = -1;
+
+ThreadPool::ThreadPool(unsigned int threads) : queued(0), pending(0), next(0), stopping(false)
+{
+	if (threads == 0) threads = 1;
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers.push_back(new Worker);
+	}
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		workers[i]->thread = thread(&ThreadPool::run, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> guard(idle_lock);
+		stopping = true;
+	}
+	work_available.notify_all();
+	for (Worker* w : workers)
+	{
+		w->thread.join();
+		delete w;
+	}
+}
+
+unsigned int ThreadPool::size() const
+{
+	return workers.size();
+}
+
+void ThreadPool::submit(Task task)
+{
+	int target;
+	if (current_pool == this) target = current_worker;
+	else target = next++ % workers.size();
+
+	pending++;
+	{
+		lock_guard<mutex> guard(workers[target]->lock);
+		workers[target]->tasks.push_back(std::move(task));
+	}
+	{
+		lock_guard<mutex> guard(idle_lock);
+		queued++;
+	}
+	work_available.notify_one();
+}
+
+bool ThreadPool::take(int id, Task& task)
+{
+	// Own deque first, newest task (LIFO keeps the freshly split chunks cache-warm)
+	{
+		Worker* self = workers[id];
+		lock_guard<mutex> guard(self->lock);
+		if (!self->tasks.empty())
+		{
+			task = std::move(self->tasks.back());
+			self->tasks.pop_back();
+			queued--;
+			return true;
+		}
+	}
+	// Otherwise steal the oldest task of another worker
+	for (unsigned int i = 1; i < workers.size(); i++)
+	{
+		Worker* victim = workers[(id + i) % workers.size()];
+		lock_guard<mutex> guard(victim->lock);
+		if (!victim->tasks.empty())
+		{
+			task = std::move(victim->tasks.front());
+			victim->tasks.pop_front();
+			queued--;
+			workers[id]->stolen++;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::run(int id)
+{
+	current_pool = this;
+	current_worker = id;
+	Worker* self = workers[id];
+	while (true)
+	{
+		Task task;
+		if (take(id, task))
+		{
+			auto start = chrono::steady_clock::now();
+			task(id);
+			self->busy += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			self->executed++;
+			if (--pending == 0)
+			{
+				lock_guard<mutex> guard(idle_lock);
+				all_done.notify_all();
+			}
+			continue;
+		}
+		unique_lock<mutex> guard(idle_lock);
+		work_available.wait(guard, [this] { return stopping || queued > 0; });
+		if (stopping && queued == 0) return;
+	}
+}
+
+bool ThreadPool::waitFor(chrono::milliseconds timeout)
+{
+	unique_lock<mutex> guard(idle_lock);
+	return all_done.wait_for(guard, timeout, [this] { return pending == 0; });
+}
+
+void ThreadPool::wait()
+{
+	unique_lock<mutex> guard(idle_lock);
+	all_done.wait(guard, [this] { return pending == 0; });
+}
+
+void ThreadPool::printStats(double elapsed)
+{
+	cout << "Worker utilization:" << endl;
+	for (unsigned int i = 0; i < workers.size(); i++)
+	{
+		Worker* w = workers[i];
+		double utilization = elapsed > 0 ? 100.0 * w->busy / elapsed : 0;
+		cout << "  worker " << setw(2) << i << ": " << setw(6) << w->executed << " tasks, "
+			 << setw(5) << w->stolen << " stolen, busy " << fixed << setprecision(3) << w->busy << "s ("
+			 << setprecision(1) << utilization << "%)" << endl;
+	}
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
@@ -0,0 +1,57 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Work-stealing thread pool used by the multi-file import
+//============================================================================
+
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using std::vector;
+
+class ThreadPool
+{
+	public:
+		typedef std::function<void(int)> Task;		// receives the index of the worker running it
+
+	private:
+		struct Worker
+		{
+			std::deque<Task> tasks;					// owner pops the back, thieves take the front
+			std::mutex lock;
+			std::thread thread;
+			unsigned long executed = 0;				// tasks run by this worker
+			unsigned long stolen = 0;				// of those, taken from another worker
+			double busy = 0;						// seconds spent inside tasks
+		};
+		vector<Worker*> workers;
+		std::atomic<long> queued;					// tasks sitting in some deque
+		std::atomic<long> pending;					// tasks submitted but not yet finished
+		std::atomic<unsigned int> next;				// round-robin target for outside submits
+		std::mutex idle_lock;
+		std::condition_variable work_available;
+		std::condition_variable all_done;
+		bool stopping;
+
+		void run(int id);							// worker main loop
+		bool take(int id, Task& task);				// pop own deque, else steal from the others
+
+	public:
+		ThreadPool(unsigned int threads);
+		~ThreadPool();
+		unsigned int size() const;
+		void submit(Task task);						// from a worker: its own deque, otherwise round-robin
+		bool waitFor(std::chrono::milliseconds timeout);	// true once every task has finished
+		void wait();
+		void printStats(double elapsed);			// per-worker tasks, steals and utilization
+};
+#endif
@@ -0,0 +1,46 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word tokenizer/normalizer shared by all import paths
+//============================================================================
+#include "tokenizer.h"
+
+// Build the lookup table once from the same punctuation set import has always used.
+// The curly quotes are multi-byte UTF-8, so every one of their bytes counts as punctuation.
+const bool* Tokenizer::punctuationTable()
+{
+	static bool table[256];
+	static bool initialized = [] {
+		const string punctuation = ".,!?;\"'“”‘’"; //#[]:()-
+		for (char c : punctuation)
+		{
+			table[(unsigned char)c] = true;
+		}
+		return true;
+	}();
+	(void)initialized;
+	return table;
+}
+
+bool Tokenizer::normalize(const char* begin, const char* end, string& out)
+{
+	// Remove punctuation from the start
+	while (begin < end && isPunctuation(*begin))
+	{
+		++begin;
+	}
+	// Remove punctuation from the end
+	while (end > begin && isPunctuation(*(end - 1)))
+	{
+		--end;
+	}
+	out.assign(begin, end);
+	// Convert to lowercase (ASCII only, like tolower in the "C" locale)
+	for (char &c : out)
+	{
+		if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+	}
+	return !out.empty();
+}
@@ -0,0 +1,56 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word tokenizer/normalizer shared by all import paths
+//============================================================================
+
+#ifndef _TOKENIZER_H
+#define _TOKENIZER_H
+#include <string>
+using std::string;
+
+class Tokenizer
+{
+	private:
+		static const bool* punctuationTable();		// 256-entry lookup built from the punctuation set
+
+	public:
+		static bool isSpace(char c);				// same whitespace set as operator>> in the "C" locale
+		static bool isPunctuation(char c);			// any byte of .,!?;"'“”‘’
+		// Strip leading/trailing punctuation from [begin,end) and lowercase it into out.
+		// Returns false if nothing is left of the word.
+		static bool normalize(const char* begin, const char* end, string& out);
+		// Split [begin,end) on whitespace and call emit(const string&) for every normalized word
+		template <typename Emit>
+		static void forEachWord(const char* begin, const char* end, Emit emit);
+};
+
+inline bool Tokenizer::isSpace(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool Tokenizer::isPunctuation(char c)
+{
+	return punctuationTable()[(unsigned char)c];
+}
+
+template <typename Emit>
+void Tokenizer::forEachWord(const char* begin, const char* end, Emit emit)
+{
+	string word;
+	const char* p = begin;
+	while (p < end)
+	{
+		while (p < end && isSpace(*p)) ++p;
+		const char* start = p;
+		while (p < end && !isSpace(*p)) ++p;
+		if (start < p && normalize(start, p, word))
+		{
+			emit(word);
+		}
+	}
+}
+#endif
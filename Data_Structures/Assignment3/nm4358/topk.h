@@ -0,0 +1,67 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Bounded selection of the k most frequent words
+//============================================================================
+
+#ifndef _TOPK_H
+#define _TOPK_H
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+using std::string;
+using std::vector;
+
+typedef std::pair<string, unsigned int> WordCount;
+
+// Keeps the best k offers in a min-heap: O(n log k) over n offers.
+// Higher counts rank first, ties in alphabetical order.
+class TopK
+{
+	private:
+		struct Better
+		{
+			bool operator()(const WordCount& a, const WordCount& b) const
+			{
+				return a.second != b.second ? a.second > b.second : a.first < b.first;
+			}
+		};
+		unsigned int k;
+		std::priority_queue<WordCount, vector<WordCount>, Better> best;	// top() is the weakest kept
+
+	public:
+		TopK(unsigned int k) : k(k) {}
+		void offer(std::string_view word, unsigned int count)
+		{
+			if (best.size() < k)
+			{
+				best.push(WordCount(string(word), count));
+				return;
+			}
+			if (k == 0) return;
+			// Compare before copying the word: most offers lose to the weakest kept
+			const WordCount& weakest = best.top();
+			if (count > weakest.second || (count == weakest.second && word < weakest.first))
+			{
+				best.pop();
+				best.push(WordCount(string(word), count));
+			}
+		}
+		vector<WordCount> result()				// best first, empties the selection
+		{
+			vector<WordCount> words;
+			while (!best.empty())
+			{
+				words.push_back(best.top());
+				best.pop();
+			}
+			std::reverse(words.begin(), words.end());
+			return words;
+		}
+};
+#endif
@@ -0,0 +1,124 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word frequencies over the last N tokens or N minutes
+//============================================================================
+#include "windowcounter.h"
+#include <algorithm>
+using namespace std;
+
+WindowCounter::WindowCounter(Mode mode, unsigned long size) : mode(mode), size(max(1UL, size)), current(0), window_tokens(0)
+{
+	if (mode == TOKENS)
+	{
+		// Full panes plus the one being filled stay within one pane of the window length
+		unsigned long count = min<unsigned long>(PANES, this->size);
+		pane_length = (this->size + count - 1) / count;
+		panes.resize((this->size + pane_length - 1) / pane_length);
+	}
+	else
+	{
+		pane_length = 0;
+		panes.resize(PANES);
+	}
+	panes[current].start = Clock::now();
+}
+
+void WindowCounter::expire(Pane& pane)
+{
+	for (auto& entry : pane.counts)
+	{
+		auto it = totals.find(entry.first);
+		it->second -= entry.second;
+		if (it->second == 0) totals.erase(it);
+	}
+	window_tokens -= pane.tokens;
+	pane.counts.clear();		// keeps its buckets for the next time the pane is reused
+	pane.tokens = 0;
+}
+
+void WindowCounter::rotate(Clock::time_point now)
+{
+	current = (current + 1) % panes.size();
+	expire(panes[current]);
+	panes[current].start = now;
+}
+
+void WindowCounter::advance(Clock::time_point now)
+{
+	if (mode != MINUTES) return;
+	Clock::duration length = chrono::duration_cast<Clock::duration>(chrono::minutes(size)) / PANES;
+	int steps = 0;
+	while (now - panes[current].start >= length)
+	{
+		// Idle for longer than the whole window: everything has aged out
+		if (++steps > PANES)
+		{
+			for (Pane& pane : panes) expire(pane);
+			panes[current].start = now;
+			return;
+		}
+		rotate(panes[current].start + length);
+	}
+}
+
+void WindowCounter::add(const string& word, unsigned int count)
+{
+	if (mode == MINUTES)
+	{
+		advance(Clock::now());
+	}
+	else
+	{
+		if (panes[current].tokens >= pane_length) rotate(Clock::now());
+	}
+	panes[current].counts[word] += count;
+	panes[current].tokens += count;
+	totals[word] += count;
+	window_tokens += count;
+}
+
+unsigned int WindowCounter::find_freq(const string& word)
+{
+	advance(Clock::now());
+	auto it = totals.find(word);
+	return it == totals.end() ? 0 : it->second;
+}
+
+vector<WordCount> WindowCounter::topK(unsigned int k)
+{
+	advance(Clock::now());
+	// Only the words inside the window are looked at, never the token history
+	TopK best(k);
+	for (auto& entry : totals)
+	{
+		best.offer(entry.first, entry.second);
+	}
+	return best.result();
+}
+
+unsigned long WindowCounter::getTokens()
+{
+	advance(Clock::now());
+	return window_tokens;
+}
+
+string WindowCounter::describe() const
+{
+	return "last " + to_string(size) + (mode == TOKENS ? " tokens" : " minutes");
+}
+
+void WindowCounter::clear()
+{
+	for (Pane& pane : panes)
+	{
+		pane.counts.clear();
+		pane.tokens = 0;
+	}
+	totals.clear();
+	window_tokens = 0;
+	current = 0;
+	panes[current].start = Clock::now();
+}
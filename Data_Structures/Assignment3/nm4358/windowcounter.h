@@ -0,0 +1,61 @@
+//============================================================================
+// Author       : Nikhil Mundhra
+// Version      : 1.0
+// Date Created : 19-10-2026
+// Date Modified: 19-10-2026
+// Description  : Word frequencies over the last N tokens or N minutes
+//============================================================================
+
+#ifndef _WINDOWCOUNTER_H
+#define _WINDOWCOUNTER_H
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "topk.h"
+using std::string;
+using std::vector;
+
+// The window is cut into at most PANES slices. Every word is counted in the newest pane
+// and in the running totals; when a pane falls out of the window its counts are
+// subtracted from the totals. Each occurrence is added and expired exactly once,
+// so the cost per token is O(1) amortized and history is never rescanned.
+// A window of N tokens has min(PANES, N) panes of L = ceil(N / panes) tokens and
+// covers between N - L + 1 and N + L - 1 of the latest tokens, exactly N when N <= PANES.
+// A window of N minutes has PANES panes and covers N minutes, give or take one pane.
+class WindowCounter
+{
+	public:
+		enum Mode { TOKENS, MINUTES };
+		static constexpr int PANES = 16;
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+		struct Pane
+		{
+			std::unordered_map<string, unsigned int> counts;
+			unsigned long tokens = 0;
+			Clock::time_point start;
+		};
+		Mode mode;
+		unsigned long size;						// window length in tokens or minutes
+		unsigned long pane_length;				// tokens per pane in TOKENS mode
+		vector<Pane> panes;						// ring buffer, panes[current] is being filled
+		int current;
+		std::unordered_map<string, unsigned int> totals;	// sum of all live panes
+		unsigned long window_tokens;			// tokens inside the window
+
+		void expire(Pane& pane);				// subtract a pane from the totals and empty it
+		void rotate(Clock::time_point now);		// start a new pane, expiring the oldest
+		void advance(Clock::time_point now);	// in MINUTES mode, drop panes that aged out
+
+	public:
+		WindowCounter(Mode mode, unsigned long size);
+		void add(const string& word, unsigned int count = 1);
+		unsigned int find_freq(const string& word);
+		vector<WordCount> topK(unsigned int k);
+		unsigned long getTokens();				// tokens currently inside the window
+		string describe() const;				// e.g. "last 10000 tokens"
+		void clear();							// forget every word, keep the window settings
+};
+#endif